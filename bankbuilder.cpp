@@ -0,0 +1,115 @@
+// Builds the puzzle bank the game picks new puzzles from (see puzzlebank.h).
+//
+// Usage: BankBuilder [-n per-difficulty] [-s seed] [-t threads] [-o file]
+//   -n  puzzles per difficulty (default 10000)
+//   -s  base seed, difficulty d uses seeds seed + (d - 1) * n onwards (default random)
+//   -t  worker threads, 0 = all cores (default 0)
+//   -o  output file (default puzzles.bank), place it next to the game executable
+// The same -n and -s always produce the same file.
+
+#include "puzzlebank.h"
+#include "sudokulogic.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct Options {
+    long long perDifficulty = 10000;
+    uint64_t seed = 0;
+    bool seeded = false;
+    int threads = 0;
+    const char* outputPath = "puzzles.bank";
+};
+
+void printUsage() {
+    std::fprintf(stderr, "Usage: BankBuilder [-n per-difficulty] [-s seed] [-t threads] [-o file]\n");
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if (std::strcmp(arg, "-n") == 0) options.perDifficulty = std::atoll(value);
+        else if (std::strcmp(arg, "-s") == 0) {
+            options.seed = std::strtoull(value, nullptr, 0);
+            options.seeded = true;
+        }
+        else if (std::strcmp(arg, "-t") == 0) options.threads = std::atoi(value);
+        else if (std::strcmp(arg, "-o") == 0) options.outputPath = value;
+        else return false;
+        ++i;
+    }
+    return options.perDifficulty > 0 && options.perDifficulty <= 0x7FFFFFFF / BANK_SECTIONS && options.threads >= 0;
+}
+
+// Record r belongs to difficulty r / perDifficulty + 1 and is written straight into its slot
+void buildWorker(const BankSection* sections, long long perDifficulty, std::atomic<long long>& nextRecord, uint8_t* records) {
+    SudokuLogic logic;
+    const long long total = perDifficulty * BANK_SECTIONS;
+
+    while (true) {
+        long long record = nextRecord.fetch_add(1);
+        if (record >= total) break;
+
+        int section = static_cast<int>(record / perDifficulty);
+        uint64_t seed = sections[section].baseSeed + static_cast<uint64_t>(record % perDifficulty);
+        int board[SIZE][SIZE];
+        int solution[SIZE][SIZE];
+        logic.generatePuzzle(seed, section + 1, board, solution);
+        encodeBankRecord(board, solution, records + record * BANK_RECORD_BYTES);
+    }
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (!options.seeded) options.seed = SudokuLogic().newSeed();
+
+    int threadCount = options.threads;
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    BankSection sections[BANK_SECTIONS];
+    for (int s = 0; s < BANK_SECTIONS; ++s) {
+        sections[s].baseSeed = options.seed + static_cast<uint64_t>(s) * options.perDifficulty;
+        sections[s].first = static_cast<uint32_t>(s * options.perDifficulty);
+        sections[s].count = static_cast<uint32_t>(options.perDifficulty);
+    }
+
+    std::vector<uint8_t> file(BANK_HEADER_BYTES + options.perDifficulty * BANK_SECTIONS * BANK_RECORD_BYTES);
+    encodeBankHeader(sections, file.data());
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::atomic<long long> nextRecord(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back(buildWorker, sections, options.perDifficulty, std::ref(nextRecord), file.data() + BANK_HEADER_BYTES);
+    }
+    for (std::thread& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    std::FILE* out = std::fopen(options.outputPath, "wb");
+    if (!out || std::fwrite(file.data(), 1, file.size(), out) != file.size()) {
+        std::fprintf(stderr, "Could not write %s\n", options.outputPath);
+        if (out) std::fclose(out);
+        return 1;
+    }
+    std::fclose(out);
+
+    std::fprintf(stderr, "Wrote %lld puzzles per difficulty (seed %llu) to %s, %zu bytes, in %.3f s on %d threads\n",
+        options.perDifficulty, static_cast<unsigned long long>(options.seed), options.outputPath, file.size(), seconds, threadCount);
+    return 0;
+}
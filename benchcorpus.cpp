@@ -0,0 +1,50 @@
+#include "benchcorpus.h"
+#include "boardpacking.h"
+
+namespace {
+
+const char* SEVENTEEN_CLUE[] = {
+    "000000010400000000020000000000050407008000300001090000300400200050100000000806000",
+    "52...6.........7.13...........4..8..6......5...........418.........3..2...87.....",
+    "6.....8.3.4.7.................5.4.7.3..2.....1.6.......2.....5.....8.6......1....",
+    "48.3............71.2.......7.5....6....2..8.............1.76...3.....4......5....",
+};
+
+const char* HARDEST[] = {
+    "..............3.85..1.2.......5.7.....4...1...9.......5......73..2.1........4...9",
+    "4.....8.5.3..........7......2.....6.....8.4......1.......6.3.7.5..2.....1.4......",
+    "1....7.9..3..2...8..96..5....53..9...1..8...26....4...3......1..4......7..7...3..",
+    "........8..3...4...9..2..6.....79.......612...6.5.2.7...8...5...1.....2.4.5.....3",
+    "12.3....435....1....4........54..2..6...7.........8.9...31..5.......9.7.....6...8",
+};
+
+BenchPuzzle parsePuzzle(const char* text) {
+    BenchPuzzle p;
+    lineToBoard(text, p.cells);
+    return p;
+}
+
+} // namespace
+
+PuzzleClass generatedClass(SudokuLogic& logic, const char* name, int difficulty, int count) {
+    PuzzleClass pc{ name, {}, false };
+    for (int i = 0; i < count; ++i) {
+        BenchPuzzle p;
+        int solution[SIZE][SIZE];
+        logic.generatePuzzle(BENCH_CORPUS_SEED + static_cast<uint64_t>(i), difficulty, p.cells, solution);
+        pc.puzzles.push_back(p);
+    }
+    return pc;
+}
+
+PuzzleClass seventeenClueClass() {
+    PuzzleClass pc{ "17-clue", {}, true };
+    for (const char* text : SEVENTEEN_CLUE) pc.puzzles.push_back(parsePuzzle(text));
+    return pc;
+}
+
+PuzzleClass hardestKnownClass() {
+    PuzzleClass pc{ "hardest-known", {}, true };
+    for (const char* text : HARDEST) pc.puzzles.push_back(parsePuzzle(text));
+    return pc;
+}
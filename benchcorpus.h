@@ -0,0 +1,33 @@
+#pragma once
+#ifndef BENCHCORPUS_H
+#define BENCHCORPUS_H
+
+#include <string>
+#include <vector>
+
+#include "sudokulogic.h"
+
+// Fixed puzzle sets shared by the benchmark tools, so runs on different
+// machines and different days measure exactly the same boards.
+
+struct BenchPuzzle {
+    int cells[SIZE][SIZE];
+};
+
+struct PuzzleClass {
+    std::string name;
+    std::vector<BenchPuzzle> puzzles;
+    bool pathological; // too slow for the reference backtracker by default
+};
+
+// Seed of the first generated puzzle of every class, puzzle i uses seed + i
+const uint64_t BENCH_CORPUS_SEED = 0x5D0C0DE;
+
+// count puzzles of the difficulty (1-3) from SudokuLogic::generatePuzzle
+PuzzleClass generatedClass(SudokuLogic& logic, const char* name, int difficulty, int count);
+// Well known 17-clue puzzles (minimum possible givens)
+PuzzleClass seventeenClueClass();
+// Puzzles that are hard for digit-order backtracking or for human solvers
+PuzzleClass hardestKnownClass();
+
+#endif // BENCHCORPUS_H
@@ -0,0 +1,35 @@
+#pragma once
+#ifndef BITUTILS_H
+#define BITUTILS_H
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// Digit d (1-9) is stored as bit (d - 1), so a full set of candidates is 0x1FF.
+const unsigned int ALL_DIGITS = 0x1FF;
+
+inline unsigned int digitBit(int num) {
+    return 1u << (num - 1);
+}
+
+inline int popCount(unsigned int mask) {
+#if defined(_MSC_VER)
+    return static_cast<int>(__popcnt(mask));
+#else
+    return __builtin_popcount(mask);
+#endif
+}
+
+// Index of the lowest set bit. mask must not be 0.
+inline int lowestBit(unsigned int mask) {
+#if defined(_MSC_VER)
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<int>(index);
+#else
+    return __builtin_ctz(mask);
+#endif
+}
+
+#endif // BITUTILS_H
@@ -0,0 +1,92 @@
+#include "boardmodel.h"
+#include "boardtables.h"
+#include "candidatesolver.h"
+
+BoardModel::BoardModel() {
+    const int empty[N][N] = { { 0 } };
+    load(empty, empty);
+}
+
+void BoardModel::load(const int board[N][N], const int solutionBoard[N][N]) {
+    for (int i = 0; i < N; ++i) {
+        for (int digit = 0; digit <= N; ++digit) {
+            rowCount[i][digit] = colCount[i][digit] = boxCount[i][digit] = 0;
+        }
+    }
+    filled = 0;
+    wrongCells = 0;
+
+    bool hasSolution = false;
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) {
+            int value = board[row][col];
+            cells[row][col] = value;
+            cellNotes[row][col] = 0;
+            solution[row][col] = solutionBoard[row][col];
+            given[row][col] = value != 0;
+            if (solutionBoard[row][col] != 0) hasSolution = true;
+
+            rowCount[row][value]++;
+            colCount[col][value]++;
+            boxCount[ClassicBoard::boxOf(row, col)][value]++;
+            if (value != 0) filled++;
+            if (value == 0 || value != solutionBoard[row][col]) wrongCells++;
+        }
+    }
+    // Without a solution nothing can be correct, keep isSolved() false
+    if (!hasSolution) wrongCells = N * N;
+}
+
+void BoardModel::setValue(int row, int col, int value) {
+    if (given[row][col] || value < 0 || value > N) return;
+    int old = cells[row][col];
+    if (old == value) return;
+
+    int box = ClassicBoard::boxOf(row, col);
+    rowCount[row][old]--;
+    colCount[col][old]--;
+    boxCount[box][old]--;
+    rowCount[row][value]++;
+    colCount[col][value]++;
+    boxCount[box][value]++;
+
+    filled += (value != 0) - (old != 0);
+    bool wasWrong = old == 0 || old != solution[row][col];
+    bool isWrong = value == 0 || value != solution[row][col];
+    wrongCells += isWrong - wasWrong;
+    cells[row][col] = value;
+
+    if (value != 0) {
+        int cell = row * N + col;
+        uint16_t keep = static_cast<uint16_t>(~digitBit(value));
+        cellNotes[row][col] = 0;
+        for (int peer : CLASSIC_TABLES.peers[cell]) cellNotes[peer / N][peer % N] &= keep;
+    }
+}
+
+void BoardModel::setNotes(int row, int col, unsigned int mask) {
+    if (given[row][col] || cells[row][col] != 0) return;
+    cellNotes[row][col] = static_cast<uint16_t>(mask & ALL_DIGITS);
+}
+
+void BoardModel::fillNotes() {
+    // The candidate solver's row, column and box masks give every cell's candidates at once.
+    // Digits go in with place(), which unlike load() also accepts a board with conflicts.
+    CandidateSolver solver;
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) {
+            if (cells[row][col] != 0) solver.place(row, col, cells[row][col]);
+        }
+    }
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) {
+            cellNotes[row][col] = static_cast<uint16_t>(solver.candidates(row, col));
+        }
+    }
+}
+
+bool BoardModel::hasConflict(int row, int col) const {
+    int value = cells[row][col];
+    if (value == 0) return false;
+    return rowCount[row][value] > 1 || colCount[col][value] > 1 || boxCount[ClassicBoard::boxOf(row, col)][value] > 1;
+}
@@ -0,0 +1,59 @@
+#pragma once
+#ifndef BOARDMODEL_H
+#define BOARDMODEL_H
+
+#include <cstdint>
+
+#include "boardsize.h"
+
+// Integer copy of the board the player sees. Every row, column and box keeps a
+// count per digit, and the model tracks how many cells still differ from the
+// solution, so conflict and completion checks are O(1) per keystroke.
+// Pencil marks are a 9-bit mask per cell, bit d - 1 for digit d.
+class BoardModel {
+public:
+    static const int N = ClassicBoard::N;
+    using Grid = int[N][N];
+    using NoteGrid = uint16_t[N][N];
+
+    BoardModel();
+
+    // Starts over with the givens of board. solution may be all zeros
+    // (custom setup), isSolved() is then never true.
+    void load(const int board[N][N], const int solution[N][N]);
+
+    // Sets a non-given cell, 0 clears it. Givens are left untouched.
+    // Placing a digit drops the cell's notes and that digit from the notes of its 20 peers.
+    void setValue(int row, int col, int value);
+
+    int value(int row, int col) const { return cells[row][col]; }
+    bool isGiven(int row, int col) const { return given[row][col]; }
+    int solutionValue(int row, int col) const { return solution[row][col]; } // 0 if unknown
+    const Grid& values() const { return cells; }
+
+    unsigned int notes(int row, int col) const { return cellNotes[row][col]; }
+    const NoteGrid& allNotes() const { return cellNotes; }
+    // Only empty cells keep notes, the mask is ignored on givens and filled cells
+    void setNotes(int row, int col, unsigned int mask);
+    // Notes every candidate of every empty cell, given the digits on the board now
+    void fillNotes();
+
+    // True if the digit at (row, col) appears elsewhere in its row, column or box
+    bool hasConflict(int row, int col) const;
+    bool isSolved() const { return wrongCells == 0; }
+    int filledCount() const { return filled; }
+
+private:
+    Grid cells;
+    Grid solution;
+    bool given[N][N];
+    NoteGrid cellNotes;
+
+    uint8_t rowCount[N][N + 1];
+    uint8_t colCount[N][N + 1];
+    uint8_t boxCount[N][N + 1];
+    int filled = 0;
+    int wrongCells = 0; // cells that are empty or differ from the solution
+};
+
+#endif // BOARDMODEL_H
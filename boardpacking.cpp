@@ -0,0 +1,42 @@
+#include "boardpacking.h"
+
+void packBoard(const int board[9][9], uint8_t packed[PACKED_BOARD_BYTES]) {
+    for (int i = 0; i < PACKED_BOARD_BYTES; ++i) packed[i] = 0;
+    for (int i = 0; i < 81; ++i) {
+        uint8_t value = static_cast<uint8_t>(board[i / 9][i % 9] & 0x0F);
+        packed[i / 2] |= (i % 2 == 0) ? value : static_cast<uint8_t>(value << 4);
+    }
+}
+
+bool unpackBoard(const uint8_t packed[PACKED_BOARD_BYTES], int board[9][9]) {
+    for (int i = 0; i < 81; ++i) {
+        int value = (i % 2 == 0) ? (packed[i / 2] & 0x0F) : (packed[i / 2] >> 4);
+        if (value > 9) return false;
+        board[i / 9][i % 9] = value;
+    }
+    return true;
+}
+
+void packGivenMask(const int board[9][9], uint8_t mask[GIVEN_MASK_BYTES]) {
+    for (int i = 0; i < GIVEN_MASK_BYTES; ++i) mask[i] = 0;
+    for (int i = 0; i < 81; ++i) {
+        if (board[i / 9][i % 9] != 0) mask[i / 8] |= static_cast<uint8_t>(1u << (i % 8));
+    }
+}
+
+void boardToLine(const int board[9][9], char line[81]) {
+    for (int i = 0; i < 81; ++i) {
+        int value = board[i / 9][i % 9];
+        line[i] = value == 0 ? '.' : static_cast<char>('0' + value);
+    }
+}
+
+bool lineToBoard(const char line[81], int board[9][9]) {
+    for (int i = 0; i < 81; ++i) {
+        char ch = line[i];
+        if (ch == '.' || ch == '0') board[i / 9][i % 9] = 0;
+        else if (ch >= '1' && ch <= '9') board[i / 9][i % 9] = ch - '0';
+        else return false;
+    }
+    return true;
+}
@@ -0,0 +1,27 @@
+#pragma once
+#ifndef BOARDPACKING_H
+#define BOARDPACKING_H
+
+#include <cstdint>
+
+// 81 cells at 4 bits each, two cells per byte (the last byte holds one cell).
+const int PACKED_BOARD_BYTES = 41;
+
+void packBoard(const int board[9][9], uint8_t packed[PACKED_BOARD_BYTES]);
+// Returns false if a nibble holds a value above 9.
+bool unpackBoard(const uint8_t packed[PACKED_BOARD_BYTES], int board[9][9]);
+
+// One bit per cell, bit i set when cell i (row * 9 + col) is a given
+const int GIVEN_MASK_BYTES = 11;
+
+void packGivenMask(const int board[9][9], uint8_t mask[GIVEN_MASK_BYTES]);
+inline bool isGivenCell(const uint8_t mask[GIVEN_MASK_BYTES], int cell) {
+    return (mask[cell / 8] >> (cell % 8)) & 1;
+}
+
+// 81-character line, '.' for empty cells
+void boardToLine(const int board[9][9], char line[81]);
+// Accepts '.' or '0' for empty cells. Returns false on any other character.
+bool lineToBoard(const char line[81], int board[9][9]);
+
+#endif // BOARDPACKING_H
@@ -0,0 +1,30 @@
+#pragma once
+#ifndef BOARDSIZE_H
+#define BOARDSIZE_H
+
+#include <cstdint>
+#include <type_traits>
+
+// Compile-time geometry of a Sudoku with BoxSize x BoxSize boxes: 2 gives 4x4,
+// 3 the classic 9x9, 4 gives 16x16 and 5 gives 25x25. Candidate masks use the
+// narrowest type holding one bit per digit, uint16_t up to 16x16 and uint32_t above.
+template <int BoxSize>
+struct BoardSize {
+    static_assert(BoxSize >= 2 && BoxSize <= 5, "supported boards are 4x4 up to 25x25");
+
+    static constexpr int BOX = BoxSize;
+    static constexpr int N = BoxSize * BoxSize;
+    static constexpr int CELLS = N * N;
+    static constexpr int UNITS = 3 * N; // rows, columns, boxes
+
+    using Mask = typename std::conditional<N <= 16, uint16_t, uint32_t>::type;
+    using CellIndex = typename std::conditional<CELLS <= 256, uint8_t, uint16_t>::type;
+
+    static constexpr Mask ALL_DIGITS = static_cast<Mask>((1ull << N) - 1);
+
+    static constexpr int boxOf(int row, int col) { return (row / BOX) * BOX + col / BOX; }
+};
+
+using ClassicBoard = BoardSize<3>;
+
+#endif // BOARDSIZE_H
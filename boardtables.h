@@ -0,0 +1,77 @@
+#pragma once
+#ifndef BOARDTABLES_H
+#define BOARDTABLES_H
+
+#include "boardsize.h"
+
+// Row, column and box membership of every cell, computed at compile time so
+// the solver, generator, grader and board model walk flat arrays instead of
+// redoing the division and nested box loops on every check.
+//   units       rows 0..N-1, columns N..2N-1, boxes 2N..3N-1, each box row by row
+//   peers       the cells sharing a unit with a cell, ascending (20 on 9x9)
+//   unitsOfCell row, column and box unit of a cell
+template <int BoxSize>
+struct BoardTables {
+    using Size = BoardSize<BoxSize>;
+    using CellIndex = typename Size::CellIndex;
+    static constexpr int N = Size::N;
+    static constexpr int CELLS = Size::CELLS;
+    static constexpr int UNITS = Size::UNITS;
+    static constexpr int PEERS = 2 * (N - 1) + (Size::BOX - 1) * (Size::BOX - 1);
+
+    CellIndex units[UNITS][N] = {};
+    CellIndex peers[CELLS][PEERS] = {};
+    uint8_t unitsOfCell[CELLS][3] = {};
+};
+
+template <int BoxSize>
+constexpr BoardTables<BoxSize> makeBoardTables() {
+    using Tables = BoardTables<BoxSize>;
+    using CellIndex = typename Tables::CellIndex;
+    const int n = Tables::N;
+    const int box = BoxSize;
+
+    Tables tables;
+    for (int i = 0; i < n; ++i) {
+        for (int j = 0; j < n; ++j) {
+            tables.units[i][j] = static_cast<CellIndex>(i * n + j);
+            tables.units[n + i][j] = static_cast<CellIndex>(j * n + i);
+            tables.units[2 * n + i][j] = static_cast<CellIndex>((i / box * box + j / box) * n + i % box * box + j % box);
+        }
+    }
+    for (int cell = 0; cell < Tables::CELLS; ++cell) {
+        int row = cell / n, col = cell % n, count = 0;
+        int boxIndex = BoardSize<BoxSize>::boxOf(row, col);
+        tables.unitsOfCell[cell][0] = static_cast<uint8_t>(row);
+        tables.unitsOfCell[cell][1] = static_cast<uint8_t>(n + col);
+        tables.unitsOfCell[cell][2] = static_cast<uint8_t>(2 * n + boxIndex);
+
+        // Walk only the cell's own rows and columns, in ascending order
+        int firstRow = row / box * box, firstCol = col / box * box;
+        for (int r = 0; r < n; ++r) {
+            bool inBand = r >= firstRow && r < firstRow + box;
+            if (r == row) {
+                for (int c = 0; c < n; ++c) {
+                    if (c != col) tables.peers[cell][count++] = static_cast<CellIndex>(r * n + c);
+                }
+            }
+            else if (inBand) {
+                for (int c = 0; c < n; ++c) {
+                    if (c == col || (c >= firstCol && c < firstCol + box)) tables.peers[cell][count++] = static_cast<CellIndex>(r * n + c);
+                }
+            }
+            else {
+                tables.peers[cell][count++] = static_cast<CellIndex>(r * n + col);
+            }
+        }
+    }
+    return tables;
+}
+
+// Tables of every board size, built once by the compiler for the sizes in use
+template <int BoxSize>
+inline constexpr BoardTables<BoxSize> BOARD_TABLES = makeBoardTables<BoxSize>();
+
+inline constexpr const BoardTables<3>& CLASSIC_TABLES = BOARD_TABLES<3>;
+
+#endif // BOARDTABLES_H
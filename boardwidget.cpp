@@ -0,0 +1,284 @@
+#include "boardwidget.h"
+
+#include <QPainter>
+#include <QPaintEvent>
+#include <QKeyEvent>
+#include <QMouseEvent>
+#include <QFocusEvent>
+
+#include <algorithm>
+
+namespace {
+
+struct CellColors {
+    QColor background;
+    QColor text;
+};
+
+// Indexed by CellStyle, the colors of the former per-cell stylesheets
+const CellColors STYLE_COLORS[] = {
+    { QColor(0xff, 0xff, 0xff), QColor(0x33, 0x33, 0x33) }, // Default
+    { QColor(0xe6, 0xdb, 0xc8), QColor(0x5a, 0x4d, 0x41) }, // Given
+    { QColor(0xe0, 0xff, 0xe0), QColor(0x00, 0x64, 0x00) }, // Correct
+    { QColor(0xff, 0xe0, 0xe0), QColor(0xa0, 0x00, 0x00) }, // Incorrect
+    { QColor(0xf0, 0xf8, 0xff), QColor(0x46, 0x82, 0xb4) }, // Solution
+};
+
+const QColor BOX_LINE_COLOR(0x5a, 0x4d, 0x41);
+const QColor CELL_LINE_COLOR(0xcc, 0xcc, 0xcc);
+const QColor SELECTION_COLOR(0xd2, 0xb4, 0x8c);
+const QColor NOTES_SELECTION_COLOR(0x46, 0x82, 0xb4);
+const QColor NOTE_COLOR(0x8b, 0x7e, 0x66);
+const QColor HIGHLIGHT_COLOR(0xff, 0xd7, 0x00, 0x60); // blended over the style background
+const int NOTE_SIZE = BoardWidget::CELL_SIZE / 3;
+
+} // namespace
+
+BoardWidget::BoardWidget(QWidget* parent) : QWidget(parent) {
+    setFocusPolicy(Qt::StrongFocus);
+    // paintEvent covers every pixel of the dirty rect, no need to clear it first
+    setAttribute(Qt::WA_OpaquePaintEvent);
+    QSize size = sizeHint();
+    setFixedSize(size.width(), size.height());
+
+    digitFont = font();
+    digitFont.setPixelSize(20);
+    digitFont.setBold(true);
+    noteFont = font();
+    noteFont.setPixelSize(10);
+}
+
+// --- Cell Access ---
+
+void BoardWidget::setValue(int row, int col, int value) {
+    if (cells[row][col].value == value) return;
+    cells[row][col].value = static_cast<uint8_t>(value);
+    updateCell(row, col);
+    emit cellChanged(row, col);
+}
+
+void BoardWidget::setReadOnly(int row, int col, bool readOnly) {
+    cells[row][col].readOnly = readOnly;
+}
+
+void BoardWidget::setCellStyle(int row, int col, CellStyle style) {
+    if (cells[row][col].style == style) return;
+    cells[row][col].style = style;
+    updateCell(row, col);
+}
+
+void BoardWidget::setNotes(int row, int col, unsigned int mask) {
+    if (cells[row][col].notes == mask) return;
+    cells[row][col].notes = static_cast<uint16_t>(mask);
+    if (cells[row][col].value == 0) updateCell(row, col);
+}
+
+void BoardWidget::setHighlighted(int row, int col, bool highlighted) {
+    if (cells[row][col].highlighted == highlighted) return;
+    cells[row][col].highlighted = highlighted;
+    updateCell(row, col);
+}
+
+void BoardWidget::clearHighlights() {
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) setHighlighted(row, col, false);
+    }
+}
+
+void BoardWidget::setNotesMode(bool on) {
+    if (notesModeOn == on) return;
+    notesModeOn = on;
+    updateCell(selectedRow, selectedCol); // the selection frame shows the mode
+    emit notesModeChanged(on);
+}
+
+void BoardWidget::selectCell(int row, int col) {
+    if (row == selectedRow && col == selectedCol) return;
+    updateCell(selectedRow, selectedCol);
+    selectedRow = row;
+    selectedCol = col;
+    updateCell(selectedRow, selectedCol);
+}
+
+void BoardWidget::beginBatch() {
+    batching = true;
+    signalsWereBlocked = blockSignals(true);
+}
+
+void BoardWidget::endBatch() {
+    batching = false;
+    blockSignals(signalsWereBlocked);
+    if (!dirtyRegion.isEmpty()) {
+        update(dirtyRegion);
+        dirtyRegion = QRegion();
+    }
+}
+
+QSize BoardWidget::sizeHint() const {
+    int extent = cellOffset(N - 1) + CELL_SIZE + THICK_LINE;
+    return QSize(extent, extent);
+}
+
+// --- Geometry ---
+
+// Left (or top) edge of column (or row) index: a thick line before every box, thin ones inside it
+int BoardWidget::cellOffset(int index) {
+    int box = index / ClassicBoard::BOX;
+    return (box + 1) * THICK_LINE + (index - box) * THIN_LINE + index * CELL_SIZE;
+}
+
+QRect BoardWidget::cellRect(int row, int col) {
+    return QRect(cellOffset(col), cellOffset(row), CELL_SIZE, CELL_SIZE);
+}
+
+QRect BoardWidget::boxRect(int boxRow, int boxCol) {
+    int last = ClassicBoard::BOX - 1;
+    QRect topLeft = cellRect(boxRow * ClassicBoard::BOX, boxCol * ClassicBoard::BOX);
+    QRect bottomRight = cellRect(boxRow * ClassicBoard::BOX + last, boxCol * ClassicBoard::BOX + last);
+    return topLeft.united(bottomRight);
+}
+
+void BoardWidget::updateCell(int row, int col) {
+    if (batching) dirtyRegion += cellRect(row, col);
+    else update(cellRect(row, col));
+}
+
+bool BoardWidget::cellAt(const QPoint& point, int& row, int& col) const {
+    row = col = -1;
+    for (int i = 0; i < N; ++i) {
+        int start = cellOffset(i);
+        if (point.y() >= start && point.y() < start + CELL_SIZE) row = i;
+        if (point.x() >= start && point.x() < start + CELL_SIZE) col = i;
+    }
+    return row >= 0 && col >= 0;
+}
+
+// --- Painting ---
+
+void BoardWidget::paintEvent(QPaintEvent* event) {
+    const QRect dirty = event->rect();
+    QPainter painter(this);
+
+    // Box lines show through between the boxes, cell lines between the cells of a box
+    painter.fillRect(dirty, BOX_LINE_COLOR);
+    for (int boxRow = 0; boxRow < ClassicBoard::BOX; ++boxRow) {
+        for (int boxCol = 0; boxCol < ClassicBoard::BOX; ++boxCol) {
+            QRect box = boxRect(boxRow, boxCol);
+            if (box.intersects(dirty)) painter.fillRect(box.intersected(dirty), CELL_LINE_COLOR);
+        }
+    }
+
+    painter.setFont(digitFont);
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) {
+            QRect rect = cellRect(row, col);
+            if (!rect.intersects(dirty)) continue;
+
+            const Cell& cell = cells[row][col];
+            const CellColors& colors = STYLE_COLORS[static_cast<int>(cell.style)];
+            painter.fillRect(rect, colors.background);
+            if (cell.highlighted) painter.fillRect(rect, HIGHLIGHT_COLOR);
+            if (cell.value != 0) {
+                painter.setPen(colors.text);
+                painter.drawText(rect, Qt::AlignCenter, QString::number(cell.value));
+            }
+            else if (cell.notes != 0) {
+                painter.setFont(noteFont);
+                painter.setPen(NOTE_COLOR);
+                for (int digit = 1; digit <= N; ++digit) {
+                    if (!(cell.notes & (1u << (digit - 1)))) continue;
+                    QRect noteRect(rect.x() + 1 + (digit - 1) % 3 * NOTE_SIZE, rect.y() + 1 + (digit - 1) / 3 * NOTE_SIZE, NOTE_SIZE, NOTE_SIZE);
+                    painter.drawText(noteRect, Qt::AlignCenter, QString::number(digit));
+                }
+                painter.setFont(digitFont);
+            }
+            if (row == selectedRow && col == selectedCol && hasFocus()) {
+                painter.setPen(QPen(notesModeOn ? NOTES_SELECTION_COLOR : SELECTION_COLOR, 2));
+                painter.drawRect(rect.adjusted(1, 1, -2, -2));
+            }
+        }
+    }
+}
+
+// --- Input ---
+
+void BoardWidget::keyPressEvent(QKeyEvent* event) {
+    // Keys with Ctrl or Alt go on to the parent widgets
+    if (event->modifiers() & (Qt::ControlModifier | Qt::AltModifier)) {
+        QWidget::keyPressEvent(event);
+        return;
+    }
+
+    int key = event->key();
+    if (key >= Qt::Key_1 && key <= Qt::Key_9) {
+        typeDigit(key - Qt::Key_0);
+        return;
+    }
+
+    switch (key) {
+    case Qt::Key_0:
+    case Qt::Key_Space:
+    case Qt::Key_Delete:
+    case Qt::Key_Backspace:
+        typeDigit(0);
+        break;
+    case Qt::Key_N:
+        setNotesMode(!notesModeOn);
+        break;
+    case Qt::Key_Left:
+        selectCell(selectedRow, std::max(selectedCol - 1, 0));
+        break;
+    case Qt::Key_Right:
+        selectCell(selectedRow, std::min(selectedCol + 1, N - 1));
+        break;
+    case Qt::Key_Up:
+        selectCell(std::max(selectedRow - 1, 0), selectedCol);
+        break;
+    case Qt::Key_Down:
+        selectCell(std::min(selectedRow + 1, N - 1), selectedCol);
+        break;
+    default:
+        QWidget::keyPressEvent(event);
+        break;
+    }
+}
+
+void BoardWidget::typeDigit(int digit) {
+    Cell& cell = cells[selectedRow][selectedCol];
+    if (cell.readOnly) return;
+
+    // Notes are taken on empty cells only. On a filled cell notes mode ignores
+    // digits, and clearing falls back to the notes once the digit is gone.
+    if (notesModeOn && cell.value == 0) {
+        unsigned int mask = digit == 0 ? 0 : cell.notes ^ (1u << (digit - 1));
+        if (mask == cell.notes) return;
+        cell.notes = static_cast<uint16_t>(mask);
+        updateCell(selectedRow, selectedCol);
+        emit notesChanged(selectedRow, selectedCol);
+        return;
+    }
+    if (notesModeOn && digit != 0) return;
+    setValue(selectedRow, selectedCol, digit);
+}
+
+void BoardWidget::mousePressEvent(QMouseEvent* event) {
+#if QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+    QPoint point = event->position().toPoint();
+#else
+    QPoint point = event->pos();
+#endif
+    int row, col;
+    if (cellAt(point, row, col)) selectCell(row, col);
+    setFocus();
+}
+
+// The selection frame is only drawn while the board has the keyboard
+void BoardWidget::focusInEvent(QFocusEvent* event) {
+    QWidget::focusInEvent(event);
+    updateCell(selectedRow, selectedCol);
+}
+
+void BoardWidget::focusOutEvent(QFocusEvent* event) {
+    QWidget::focusOutEvent(event);
+    updateCell(selectedRow, selectedCol);
+}
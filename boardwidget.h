@@ -0,0 +1,104 @@
+#pragma once
+#ifndef BOARDWIDGET_H
+#define BOARDWIDGET_H
+
+#include <QWidget>
+#include <QFont>
+#include <QRect>
+#include <QRegion>
+
+#include "boardsize.h"
+
+enum class CellStyle : uint8_t { Default, Given, Correct, Incorrect, Solution };
+
+// The 9x9 grid as a single widget: cells are painted from plain ints in one
+// paintEvent instead of 81 styled QLineEdits. Changing a cell repaints only
+// its rect. Digits 1-9 type into the selected cell, 0, Space, Delete and
+// Backspace clear it, the arrow keys and the mouse move the selection.
+// In notes mode (toggled with N) digits toggle pencil marks of an empty cell
+// instead, drawn as a 3x3 grid of small digits.
+//
+// Bulk updates go between beginBatch and endBatch: the setters still skip
+// cells that already hold the new state, cellChanged is not emitted, and the
+// cells that did change are repainted together once the batch ends.
+class BoardWidget : public QWidget {
+    Q_OBJECT
+
+public:
+    static const int N = ClassicBoard::N;
+    static const int CELL_SIZE = 40;
+    static const int THIN_LINE = 1;  // between cells of a box
+    static const int THICK_LINE = 3; // between boxes and around the board
+
+    explicit BoardWidget(QWidget* parent = nullptr);
+
+    int value(int row, int col) const { return cells[row][col].value; }
+    // Emits cellChanged when the value differs, like QLineEdit::setText does
+    void setValue(int row, int col, int value);
+
+    bool isReadOnly(int row, int col) const { return cells[row][col].readOnly; }
+    void setReadOnly(int row, int col, bool readOnly);
+
+    CellStyle cellStyle(int row, int col) const { return cells[row][col].style; }
+    void setCellStyle(int row, int col, CellStyle style);
+
+    // Pencil marks, bit d - 1 for digit d. Only drawn while the cell is empty.
+    unsigned int notes(int row, int col) const { return cells[row][col].notes; }
+    void setNotes(int row, int col, unsigned int mask);
+
+    // Tints a cell, used to point at the cells a hint is about
+    bool isHighlighted(int row, int col) const { return cells[row][col].highlighted; }
+    void setHighlighted(int row, int col, bool highlighted);
+    void clearHighlights();
+
+    bool notesMode() const { return notesModeOn; }
+    void setNotesMode(bool on);
+
+    void selectCell(int row, int col);
+
+    void beginBatch();
+    void endBatch();
+
+    QSize sizeHint() const override;
+
+signals:
+    void cellChanged(int row, int col);
+    void notesChanged(int row, int col); // toggled by the player, not by setNotes
+    void notesModeChanged(bool on);
+
+protected:
+    void paintEvent(QPaintEvent* event) override;
+    void keyPressEvent(QKeyEvent* event) override;
+    void mousePressEvent(QMouseEvent* event) override;
+    void focusInEvent(QFocusEvent* event) override;
+    void focusOutEvent(QFocusEvent* event) override;
+
+private:
+    struct Cell {
+        uint8_t value = 0;
+        bool readOnly = false;
+        uint16_t notes = 0;
+        bool highlighted = false;
+        CellStyle style = CellStyle::Default;
+    };
+
+    Cell cells[N][N];
+    int selectedRow = 0;
+    int selectedCol = 0;
+    QFont digitFont;
+    QFont noteFont;
+    bool notesModeOn = false;
+
+    bool batching = false;
+    bool signalsWereBlocked = false;
+    QRegion dirtyRegion; // cells changed during the current batch
+
+    static int cellOffset(int index);
+    static QRect cellRect(int row, int col);
+    static QRect boxRect(int boxRow, int boxCol);
+    bool cellAt(const QPoint& point, int& row, int& col) const;
+    void updateCell(int row, int col);
+    void typeDigit(int digit); // 0 clears
+};
+
+#endif // BOARDWIDGET_H
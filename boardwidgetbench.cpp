@@ -0,0 +1,188 @@
+// Compares the painted BoardWidget against the former grid of 81 QLineEdits
+// with per-cell stylesheets: building, loading and first painting a board,
+// one player input (digit plus result style) and loading another puzzle into
+// a shown board, each until it has been repainted.
+//
+// Usage: BoardWidgetBench [boards] [inputs]
+//   Runs on the offscreen platform unless QT_QPA_PLATFORM is set, so the
+//   numbers leave out the window system but include all of Qt's own work.
+
+#include "boardwidget.h"
+#include "sudokulogic.h"
+#include "uihelper.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFrame>
+#include <QGridLayout>
+#include <QIntValidator>
+#include <QLineEdit>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+namespace {
+
+// --- The former board: MainWindow::setupUI and UIHelper before BoardWidget ---
+
+const char* LEGACY_SHEET = R"(
+    QLineEdit { background-color: #ffffff; border: 1px solid #cccccc; font-size: 20px; font-weight: bold; color: #333333; border-radius: 0px; min-width: 30px; min-height: 30px; }
+    QLineEdit[readOnly="true"] { background-color: #e6dbc8; color: #5a4d41; font-weight: bold; border: 1px solid #b0a593; }
+    QFrame#blockFrame { border: 2px solid #5a4d41; border-radius: 0px; background-color: transparent; }
+)";
+const char* STYLE_DEFAULT = "background-color: #ffffff; color: #333333;";
+const char* STYLE_READONLY = "background-color: #e6dbc8; color: #5a4d41; font-weight: bold; border: 1px solid #b0a593;";
+const char* STYLE_CORRECT = "background-color: #e0ffe0; color: #006400;";
+const char* STYLE_INCORRECT = "background-color: #ffe0e0; color: #a00000;";
+
+class LegacyBoard : public QFrame {
+public:
+    LegacyBoard() {
+        setStyleSheet(LEGACY_SHEET);
+        QGridLayout* mainGridLayout = new QGridLayout(this);
+        mainGridLayout->setSpacing(0);
+        mainGridLayout->setContentsMargins(0, 0, 0, 0);
+
+        for (int blockRow = 0; blockRow < 3; ++blockRow) {
+            for (int blockCol = 0; blockCol < 3; ++blockCol) {
+                QFrame* blockFrame = new QFrame();
+                blockFrame->setObjectName("blockFrame");
+                blockFrame->setFrameShape(QFrame::Box);
+
+                QGridLayout* blockLayout = new QGridLayout(blockFrame);
+                blockLayout->setSpacing(1);
+                blockLayout->setContentsMargins(1, 1, 1, 1);
+
+                for (int row = 0; row < 3; ++row) {
+                    for (int col = 0; col < 3; ++col) {
+                        QLineEdit* cell = new QLineEdit(this);
+                        cell->setAlignment(Qt::AlignCenter);
+                        cell->setMaxLength(1);
+                        cell->setFixedSize(40, 40);
+                        cell->setValidator(new QIntValidator(1, 9, this));
+                        QObject::connect(cell, &QLineEdit::textChanged, [this](const QString&) { ++inputs; });
+                        cells[blockRow * 3 + row][blockCol * 3 + col] = cell;
+                        blockLayout->addWidget(cell, row, col);
+                    }
+                }
+                mainGridLayout->addWidget(blockFrame, blockRow, blockCol);
+            }
+        }
+    }
+
+    void load(int board[SIZE][SIZE]) {
+        for (int row = 0; row < SIZE; row++) {
+            for (int col = 0; col < SIZE; col++) {
+                QLineEdit* cell = cells[row][col];
+                cell->setProperty("class", "");
+                cell->setText(board[row][col] == 0 ? QString() : QString::number(board[row][col]));
+                cell->setReadOnly(board[row][col] != 0);
+                cell->setStyleSheet(board[row][col] == 0 ? STYLE_DEFAULT : STYLE_READONLY);
+            }
+        }
+    }
+
+    void input(int row, int col, int value, bool correct) {
+        cells[row][col]->setText(QString::number(value));
+        cells[row][col]->setStyleSheet(STYLE_DEFAULT);
+        cells[row][col]->setStyleSheet(correct ? STYLE_CORRECT : STYLE_INCORRECT);
+    }
+
+    QLineEdit* cells[SIZE][SIZE];
+    int inputs = 0;
+};
+
+// --- Measurements ---
+
+struct BoardTimes {
+    double buildUs = 0; // construct, load a puzzle, show and paint once
+    double inputUs = 0; // one input until it is painted
+    double reloadUs = 0; // another puzzle into the shown board until it is painted
+};
+
+double elapsedUs(const QElapsedTimer& timer) {
+    return static_cast<double>(timer.nsecsElapsed()) / 1000.0;
+}
+
+template <typename Board>
+BoardTimes measure(int boards, int inputs, int puzzles[2][SIZE][SIZE], int solution[SIZE][SIZE],
+                   const std::function<void(Board*, int[SIZE][SIZE])>& load,
+                   const std::function<void(Board*, int, int, int, bool)>& input) {
+    BoardTimes times;
+    QElapsedTimer timer;
+    for (int i = 0; i < boards; ++i) {
+        timer.start();
+        Board* board = new Board();
+        load(board, puzzles[0]);
+        board->show();
+        QApplication::processEvents();
+        times.buildUs += elapsedUs(timer);
+        delete board;
+    }
+    times.buildUs /= boards;
+
+    Board* board = new Board();
+    load(board, puzzles[0]);
+    board->show();
+    QApplication::processEvents();
+
+    // Alternate right and wrong digits over the empty cells
+    int done = 0;
+    timer.start();
+    for (int i = 0; done < inputs; ++i) {
+        int row = (i / SIZE) % SIZE, col = i % SIZE;
+        if (puzzles[0][row][col] != 0) continue;
+        bool correct = (done & 1) == 0;
+        int value = correct ? solution[row][col] : solution[row][col] % SIZE + 1;
+        input(board, row, col, value, correct);
+        QApplication::processEvents();
+        ++done;
+    }
+    times.inputUs = elapsedUs(timer) / inputs;
+
+    timer.start();
+    for (int i = 0; i < boards; ++i) {
+        load(board, puzzles[(i + 1) % 2]);
+        QApplication::processEvents();
+    }
+    times.reloadUs = elapsedUs(timer) / boards;
+    delete board;
+    return times;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM")) qputenv("QT_QPA_PLATFORM", "offscreen");
+    QApplication app(argc, argv);
+
+    int boards = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 50;
+    int inputs = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 2000;
+
+    SudokuLogic logic;
+    int puzzles[2][SIZE][SIZE], solution[SIZE][SIZE], otherSolution[SIZE][SIZE];
+    logic.generatePuzzle(2, 2, puzzles[1], otherSolution);
+    logic.generatePuzzle(1, 2, puzzles[0], solution);
+
+    BoardTimes legacy = measure<LegacyBoard>(boards, inputs, puzzles, solution,
+        [](LegacyBoard* board, int puzzle[SIZE][SIZE]) { board->load(puzzle); },
+        [](LegacyBoard* board, int row, int col, int value, bool correct) { board->input(row, col, value, correct); });
+
+    UIHelper uiHelper;
+    BoardTimes painted = measure<BoardWidget>(boards, inputs, puzzles, solution,
+        [&](BoardWidget* board, int puzzle[SIZE][SIZE]) { bool inProgress; uiHelper.updateBoardUI(puzzle, board, inProgress); },
+        [](BoardWidget* board, int row, int col, int value, bool correct) {
+            board->setValue(row, col, value);
+            board->setCellStyle(row, col, CellStyle::Default);
+            board->setCellStyle(row, col, correct ? CellStyle::Correct : CellStyle::Incorrect);
+        });
+
+    std::printf("%-14s %16s %12s %12s\n", "board", "build+paint us", "input us", "reload us");
+    std::printf("%-14s %16.1f %12.1f %12.1f\n", "81 line edits", legacy.buildUs, legacy.inputUs, legacy.reloadUs);
+    std::printf("%-14s %16.1f %12.1f %12.1f\n", "board widget", painted.buildUs, painted.inputUs, painted.reloadUs);
+    std::printf("%-14s %15.1fx %11.1fx %11.1fx\n", "speedup", legacy.buildUs / painted.buildUs,
+                legacy.inputUs / painted.inputUs, legacy.reloadUs / painted.reloadUs);
+    return 0;
+}
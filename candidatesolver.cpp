@@ -0,0 +1,206 @@
+#include "candidatesolver.h"
+
+#include <algorithm>
+
+template <int BoxSize>
+BasicCandidateSolver<BoxSize>::BasicCandidateSolver() {
+    std::fill(cells, cells + CELLS, 0);
+    std::fill(rowUsed, rowUsed + N, 0);
+    std::fill(colUsed, colUsed + N, 0);
+    std::fill(boxUsed, boxUsed + N, 0);
+}
+
+template <int BoxSize>
+bool BasicCandidateSolver<BoxSize>::load(const int board[N][N]) {
+    std::fill(cells, cells + CELLS, 0);
+    std::fill(rowUsed, rowUsed + N, 0);
+    std::fill(colUsed, colUsed + N, 0);
+    std::fill(boxUsed, boxUsed + N, 0);
+
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) {
+            int num = board[row][col];
+            if (num == 0) continue;
+            if (num < 1 || num > N) return false;
+            if (!(candidates(row, col) & digitBit(num))) return false; // conflict
+            place(row, col, num);
+        }
+    }
+    return true;
+}
+
+template <int BoxSize>
+unsigned int BasicCandidateSolver<BoxSize>::candidates(int row, int col) const {
+    if (cells[row * N + col] != 0) return 0;
+    return Size::ALL_DIGITS & ~(rowUsed[row] | colUsed[col] | boxUsed[Size::boxOf(row, col)]);
+}
+
+template <int BoxSize>
+void BasicCandidateSolver<BoxSize>::place(int row, int col, int num) {
+    Mask bit = static_cast<Mask>(digitBit(num));
+    cells[row * N + col] = static_cast<uint8_t>(num);
+    rowUsed[row] |= bit;
+    colUsed[col] |= bit;
+    boxUsed[Size::boxOf(row, col)] |= bit;
+}
+
+template <int BoxSize>
+void BasicCandidateSolver<BoxSize>::unplace(int row, int col) {
+    int num = cells[row * N + col];
+    if (num == 0) return;
+    Mask bit = static_cast<Mask>(digitBit(num));
+    cells[row * N + col] = 0;
+    rowUsed[row] &= ~bit;
+    colUsed[col] &= ~bit;
+    boxUsed[Size::boxOf(row, col)] &= ~bit;
+}
+
+template <int BoxSize>
+int BasicCandidateSolver<BoxSize>::countSolutions(int limit, int solution[N][N]) {
+    emptyCount = 0;
+    for (int i = 0; i < CELLS; ++i) {
+        if (cells[i] == 0) emptyCells[emptyCount++] = static_cast<CellIndex>(i);
+    }
+
+    int count = 0;
+    search(0, limit, count, solution);
+    return count;
+}
+
+template <int BoxSize>
+bool BasicCandidateSolver<BoxSize>::hasAlternative(int row, int col, int num, int alternative[N][N]) {
+    int cell = row * N + col;
+    return hasAlternative(&cell, &num, 1, alternative);
+}
+
+template <int BoxSize>
+bool BasicCandidateSolver<BoxSize>::hasAlternative(const int groupCells[], const int values[], int count, int alternative[N][N]) {
+    budgeted = searchBudget > 0;
+    nodesLeft = searchBudget;
+
+    bool found = false;
+    int placed = 0;
+    for (int i = 0; i < count && !found; ++i) {
+        int row = groupCells[i] / N;
+        int col = groupCells[i] % N;
+        unsigned int others = candidates(row, col) & ~digitBit(values[i]);
+        while (others && !found) {
+            int other = lowestBit(others) + 1;
+            others &= others - 1;
+
+            place(row, col, other);
+            found = countSolutions(1, alternative) > 0 || (budgeted && nodesLeft == 0); // out of budget counts as found
+            unplace(row, col);
+        }
+        if (i + 1 < count) {
+            place(row, col, values[i]);
+            placed++;
+        }
+    }
+    for (int i = 0; i < placed; ++i) unplace(groupCells[i] / N, groupCells[i] % N);
+
+    budgeted = false;
+    return found;
+}
+
+template <int BoxSize>
+unsigned int BasicCandidateSolver<BoxSize>::candidatesOf(int cell) const {
+    if (cells[cell] != 0) return 0;
+    const uint8_t* units = BOARD_TABLES<BoxSize>.unitsOfCell[cell];
+    return Size::ALL_DIGITS & ~(rowUsed[units[0]] | colUsed[units[1] - N] | boxUsed[units[2] - 2 * N]);
+}
+
+template <int BoxSize>
+bool BasicCandidateSolver<BoxSize>::findHiddenSingle(int& cell, unsigned int& digit) const {
+    cell = -1;
+    for (const auto& unitCells : BOARD_TABLES<BoxSize>.units) {
+        unsigned int once = 0, twice = 0, placed = 0;
+        for (int c : unitCells) {
+            unsigned int mask = candidatesOf(c);
+            twice |= once & mask;
+            once |= mask;
+            if (cells[c]) placed |= digitBit(cells[c]);
+        }
+        if ((once | placed) != Size::ALL_DIGITS) return false;
+
+        unsigned int singles = once & ~twice;
+        if (singles == 0) continue;
+        digit = singles & (0u - singles);
+        for (int c : unitCells) {
+            cell = c;
+            if (candidatesOf(cell) & digit) return true;
+        }
+    }
+    return true;
+}
+
+template <int BoxSize>
+void BasicCandidateSolver<BoxSize>::search(int depth, int limit, int& count, int solution[N][N]) {
+    if (budgeted) {
+        if (nodesLeft == 0) return;
+        nodesLeft--;
+    }
+    SOLVER_STAT(if (stats) {
+        stats->nodes++;
+        stats->maxDepth = std::max(stats->maxDepth, depth);
+    });
+
+    if (depth == emptyCount) {
+        // no empty cell left, a solution is reached
+        if (count == 0 && solution) {
+            for (int i = 0; i < CELLS; ++i) solution[i / N][i % N] = cells[i];
+        }
+        count++;
+        return;
+    }
+
+    // Pick the empty cell with the fewest candidates
+    int best = depth;
+    unsigned int bestMask = candidatesOf(emptyCells[depth]);
+    int bestCount = popCount(bestMask);
+    for (int i = depth + 1; i < emptyCount && bestCount > 1; ++i) {
+        unsigned int mask = candidatesOf(emptyCells[i]);
+        int maskCount = popCount(mask);
+        if (maskCount < bestCount) {
+            best = i;
+            bestMask = mask;
+            bestCount = maskCount;
+        }
+    }
+    if (bestCount == 0) { // dead end
+        SOLVER_STAT(if (stats) stats->backtracks++);
+        return;
+    }
+
+    if (bestCount > 1) {
+        int cell;
+        unsigned int digit;
+        if (!findHiddenSingle(cell, digit)) { // a digit has no place left in some unit
+            SOLVER_STAT(if (stats) stats->backtracks++);
+            return;
+        }
+        if (cell >= 0) {
+            best = depth;
+            while (emptyCells[best] != cell) best++;
+            bestMask = digit;
+        }
+    }
+
+    std::swap(emptyCells[depth], emptyCells[best]);
+    int row = emptyCells[depth] / N;
+    int col = emptyCells[depth] % N;
+
+    while (bestMask && count < limit) {
+        int num = lowestBit(bestMask) + 1;
+        bestMask &= bestMask - 1;
+
+        place(row, col, num);
+        search(depth + 1, limit, count, solution);
+        unplace(row, col);
+    }
+}
+
+template class BasicCandidateSolver<2>;
+template class BasicCandidateSolver<3>;
+template class BasicCandidateSolver<4>;
+template class BasicCandidateSolver<5>;
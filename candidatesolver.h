@@ -0,0 +1,86 @@
+#pragma once
+#ifndef CANDIDATESOLVER_H
+#define CANDIDATESOLVER_H
+
+#include <cstdint>
+
+#include "bitutils.h"
+#include "boardsize.h"
+#include "boardtables.h"
+#include "solverstats.h"
+
+// Backtracking solver that keeps the used digits of every row, column and box
+// as bitmasks. Placing or removing a digit only touches three masks, so the
+// search never copies or rescans the board. It branches on a cell with one
+// candidate, then on a digit with one place left in a unit, then on the cell
+// with the fewest candidates.
+// Instantiated for box sizes 2-5 in candidatesolver.cpp.
+template <int BoxSize>
+class BasicCandidateSolver {
+public:
+    using Size = BoardSize<BoxSize>;
+    using Mask = typename Size::Mask;
+    static const int N = Size::N;
+    static const int CELLS = Size::CELLS;
+
+    BasicCandidateSolver();
+
+    // Loads a board (0 = empty). Returns false if two givens conflict.
+    bool load(const int board[N][N]);
+
+    // Counts solutions of the loaded board, stopping once limit is reached.
+    // The first solution found is written to solution when it is non-null.
+    int countSolutions(int limit, int solution[N][N] = nullptr);
+
+    // True if the puzzle still has a solution with something other than num at (row, col).
+    // Used by the digger: removing a given keeps the puzzle unique exactly when this is false.
+    // The solution found is written to alternative when it is non-null, unless the call
+    // ran out of search budget.
+    bool hasAlternative(int row, int col, int num, int alternative[N][N] = nullptr);
+
+    // The same for a group of count empty cells (row * N + col) removed together: true if
+    // some solution differs from values in at least one of them. Cell i is tried with every
+    // other digit while cells 0..i-1 hold their values, so one search covers the group.
+    bool hasAlternative(const int groupCells[], const int values[], int count, int alternative[N][N] = nullptr);
+
+    // Caps the search nodes of one hasAlternative call, 0 = no cap. A call that runs
+    // out answers true, so a digger keeps givens it cannot cheaply prove redundant.
+    void setSearchBudget(long long nodes) { searchBudget = nodes; }
+
+    // Search counters are added to stats when solver statistics are compiled in, null = off.
+    // Copies share the target, give each thread its own.
+    void setStats(SolverStats* target) { stats = target; }
+
+    void place(int row, int col, int num);
+    void unplace(int row, int col);
+
+    int valueAt(int row, int col) const { return cells[row * N + col]; }
+    unsigned int candidates(int row, int col) const;
+
+private:
+    using CellIndex = typename Size::CellIndex;
+
+    void search(int depth, int limit, int& count, int solution[N][N]);
+    // Sets cell to -1 if no unit has a hidden single. False if a digit fits nowhere in a unit.
+    bool findHiddenSingle(int& cell, unsigned int& digit) const;
+    // candidates() by cell index (row * N + col)
+    unsigned int candidatesOf(int cell) const;
+
+    uint8_t cells[CELLS];
+    Mask rowUsed[N];
+    Mask colUsed[N];
+    Mask boxUsed[N];
+
+    // Empty cells of the current search, reordered in place as cells get chosen
+    CellIndex emptyCells[CELLS];
+    int emptyCount = 0;
+
+    long long searchBudget = 0;
+    long long nodesLeft = 0;
+    bool budgeted = false;
+    SolverStats* stats = nullptr;
+};
+
+using CandidateSolver = BasicCandidateSolver<3>;
+
+#endif // CANDIDATESOLVER_H
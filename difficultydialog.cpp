@@ -50,14 +50,16 @@ DifficultyDialog::DifficultyDialog(QWidget* parent) : QDialog(parent)
     rbEasy = new QRadioButton("Easy", this);
     rbMedium = new QRadioButton("Medium", this);
     rbHard = new QRadioButton("Hard", this);
+    rbExpert = new QRadioButton("Expert (minimal clues)", this);
     rbCustom = new QRadioButton("Custom Board", this);
 
     rbMedium->setChecked(true); // Default
 
     buttonGroup = new QButtonGroup(this);
-    buttonGroup->addButton(rbEasy, 1); //1=Easy, 2=Medium, 3=Hard, 0=Custom
+    buttonGroup->addButton(rbEasy, 1); //1=Easy, 2=Medium, 3=Hard, 4=Expert, 0=Custom
     buttonGroup->addButton(rbMedium, 2);
     buttonGroup->addButton(rbHard, 3);
+    buttonGroup->addButton(rbExpert, 4);
     buttonGroup->addButton(rbCustom, 0);
 
     btnOk = new QPushButton("OK", this);
@@ -73,6 +75,7 @@ DifficultyDialog::DifficultyDialog(QWidget* parent) : QDialog(parent)
     mainLayout->addWidget(rbEasy);
     mainLayout->addWidget(rbMedium);
     mainLayout->addWidget(rbHard);
+    mainLayout->addWidget(rbExpert);
     mainLayout->addWidget(rbCustom);
     mainLayout->addSpacing(20);
     mainLayout->addLayout(buttonLayout);
@@ -23,6 +23,7 @@ private:
     QRadioButton* rbEasy;
     QRadioButton* rbMedium;
     QRadioButton* rbHard;
+    QRadioButton* rbExpert;
     QRadioButton* rbCustom;
     QButtonGroup* buttonGroup;
     QPushButton* btnOk;
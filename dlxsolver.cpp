@@ -0,0 +1,165 @@
+#include "dlxsolver.h"
+#include "boardsize.h"
+
+DlxSolver::DlxSolver() {
+    // Column headers in a circular list around the root
+    for (int col = 0; col <= COLUMNS; ++col) {
+        left[col] = col - 1;
+        right[col] = col + 1;
+        up[col] = down[col] = col;
+        column[col] = col;
+        rowOf[col] = -1;
+        columnSize[col] = 0;
+        columnCovered[col] = false;
+    }
+    left[ROOT] = COLUMNS;
+    right[COLUMNS] = ROOT;
+
+    int node = COLUMNS + 1;
+    for (int row = 0; row < N; ++row) {
+        for (int col = 0; col < N; ++col) {
+            int box = ClassicBoard::boxOf(row, col);
+            for (int d = 0; d < N; ++d) {
+                int matrixRow = (row * N + col) * N + d;
+                int constraints[4] = {
+                    1 + row * N + col,              // cell is filled
+                    1 + CELLS + row * N + d,        // row has digit
+                    1 + 2 * CELLS + col * N + d,    // column has digit
+                    1 + 3 * CELLS + box * N + d     // box has digit
+                };
+
+                firstNode[matrixRow] = node;
+                for (int k = 0; k < 4; ++k) {
+                    int c = constraints[k];
+                    column[node] = c;
+                    rowOf[node] = matrixRow;
+
+                    // Append to the bottom of the column
+                    up[node] = up[c];
+                    down[node] = c;
+                    down[up[c]] = node;
+                    up[c] = node;
+                    columnSize[c]++;
+
+                    // Link within the row
+                    left[node] = (k == 0) ? node : node - 1;
+                    right[node] = (k == 0) ? node : firstNode[matrixRow];
+                    if (k > 0) {
+                        right[node - 1] = node;
+                        left[firstNode[matrixRow]] = node;
+                    }
+                    node++;
+                }
+            }
+        }
+    }
+}
+
+void DlxSolver::cover(int col) {
+    columnCovered[col] = true;
+    right[left[col]] = right[col];
+    left[right[col]] = left[col];
+    for (int i = down[col]; i != col; i = down[i]) {
+        for (int j = right[i]; j != i; j = right[j]) {
+            down[up[j]] = down[j];
+            up[down[j]] = up[j];
+            columnSize[column[j]]--;
+        }
+    }
+}
+
+void DlxSolver::uncover(int col) {
+    for (int i = up[col]; i != col; i = up[i]) {
+        for (int j = left[i]; j != i; j = left[j]) {
+            columnSize[column[j]]++;
+            down[up[j]] = j;
+            up[down[j]] = j;
+        }
+    }
+    right[left[col]] = col;
+    left[right[col]] = col;
+    columnCovered[col] = false;
+}
+
+void DlxSolver::selectRow(int node) {
+    cover(column[node]);
+    for (int j = right[node]; j != node; j = right[j]) cover(column[j]);
+}
+
+void DlxSolver::unselectRow(int node) {
+    for (int j = left[node]; j != node; j = left[j]) uncover(column[j]);
+    uncover(column[node]);
+}
+
+int DlxSolver::countSolutions(const int board[N][N], int limit, int solution[N][N]) {
+    int count = 0;
+    bool conflict = false;
+    givenCount = 0;
+
+    for (int row = 0; row < N && !conflict; ++row) {
+        for (int col = 0; col < N; ++col) {
+            int num = board[row][col];
+            if (num == 0) continue;
+            if (num < 1 || num > N) { conflict = true; break; }
+
+            int node = firstNode[(row * N + col) * N + (num - 1)];
+            // A given whose constraint is already satisfied clashes with an earlier one
+            for (int k = 0, j = node; k < 4; ++k, j = right[j]) {
+                if (columnCovered[column[j]]) conflict = true;
+            }
+            if (conflict) break;
+
+            selectRow(node);
+            givenRows[givenCount++] = node;
+        }
+    }
+
+    if (!conflict) search(0, limit, count, solution);
+
+    // Restore the matrix for the next board
+    while (givenCount > 0) unselectRow(givenRows[--givenCount]);
+
+    return count;
+}
+
+void DlxSolver::search(int depth, int limit, int& count, int solution[N][N]) {
+    SOLVER_STAT(if (stats) {
+        stats->nodes++;
+        stats->maxDepth = std::max(stats->maxDepth, depth);
+    });
+    if (right[ROOT] == ROOT) {
+        if (count == 0 && solution) recordSolution(depth, solution);
+        count++;
+        return;
+    }
+
+    // Choose the column with the fewest remaining rows
+    int best = right[ROOT];
+    for (int col = right[best]; col != ROOT && columnSize[best] > 1; col = right[col]) {
+        if (columnSize[col] < columnSize[best]) best = col;
+    }
+    if (columnSize[best] == 0) { // dead end
+        SOLVER_STAT(if (stats) stats->backtracks++);
+        return;
+    }
+
+    cover(best);
+    for (int r = down[best]; r != best && count < limit; r = down[r]) {
+        searchRows[depth] = r;
+        for (int j = right[r]; j != r; j = right[j]) cover(column[j]);
+        search(depth + 1, limit, count, solution);
+        for (int j = left[r]; j != r; j = left[j]) uncover(column[j]);
+    }
+    uncover(best);
+}
+
+void DlxSolver::recordSolution(int depth, int solution[N][N]) {
+    for (int i = 0; i < givenCount; ++i) {
+        int matrixRow = rowOf[givenRows[i]];
+        solution[matrixRow / (N * N)][(matrixRow / N) % N] = matrixRow % N + 1;
+    }
+    for (int i = 0; i < depth; ++i) {
+        int matrixRow = rowOf[searchRows[i]];
+        solution[matrixRow / (N * N)][(matrixRow / N) % N] = matrixRow % N + 1;
+    }
+}
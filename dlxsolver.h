@@ -0,0 +1,52 @@
+#pragma once
+#ifndef DLXSOLVER_H
+#define DLXSOLVER_H
+
+#include "solverstats.h"
+
+// Exact-cover (Algorithm X / Dancing Links) Sudoku solver.
+// The 729 x 324 matrix is linked once in the constructor and every solve covers
+// the givens, searches, then uncovers them again, so the node storage is reused.
+class DlxSolver {
+public:
+    static const int N = 9;
+    static const int CELLS = N * N;
+    static const int COLUMNS = 4 * CELLS;      // cell, row-digit, col-digit, box-digit
+    static const int ROWS = CELLS * N;         // one row per (cell, digit)
+    static const int NODES = 1 + COLUMNS + ROWS * 4;
+
+    DlxSolver();
+
+    // Counts solutions of board (0 = empty), stopping once limit is reached.
+    // The first solution found is written to solution when it is non-null.
+    // Conflicting givens count as no solution.
+    int countSolutions(const int board[N][N], int limit, int solution[N][N] = nullptr);
+
+    // Search counters are added to stats when solver statistics are compiled in, null = off
+    void setStats(SolverStats* target) { stats = target; }
+
+private:
+    void cover(int col);
+    void uncover(int col);
+    void selectRow(int node);
+    void unselectRow(int node);
+    void search(int depth, int limit, int& count, int solution[N][N]);
+    void recordSolution(int depth, int solution[N][N]);
+
+    static const int ROOT = 0;
+
+    // Node links, indexed by node id; ids 1..COLUMNS are the column headers
+    int left[NODES], right[NODES], up[NODES], down[NODES];
+    int column[NODES];
+    int rowOf[NODES];
+    int columnSize[COLUMNS + 1];
+    bool columnCovered[COLUMNS + 1];
+
+    int firstNode[ROWS];        // first node of each matrix row
+    int givenRows[CELLS];       // rows selected for the givens of the current board
+    int givenCount = 0;
+    int searchRows[CELLS];      // rows chosen by the search, by depth
+    SolverStats* stats = nullptr;
+};
+
+#endif // DLXSOLVER_H
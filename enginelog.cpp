@@ -0,0 +1,27 @@
+#include "enginelog.h"
+
+#include <atomic>
+#include <cstdarg>
+#include <cstdio>
+
+namespace {
+
+std::atomic<EngineLogSink> logSink(nullptr);
+
+} // namespace
+
+void setEngineLogSink(EngineLogSink sink) {
+    logSink.store(sink);
+}
+
+void engineLog(const char* format, ...) {
+    char message[256];
+    va_list args;
+    va_start(args, format);
+    std::vsnprintf(message, sizeof(message), format, args);
+    va_end(args);
+
+    EngineLogSink sink = logSink.load();
+    if (sink) sink(message);
+    else std::fprintf(stderr, "%s\n", message);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#ifndef ENGINELOG_H
+#define ENGINELOG_H
+
+// Diagnostics of the engine library. ENGINE_LOG compiles to nothing unless
+// SUDOKU_ENGINE_LOGGING is defined, so release builds pay nothing for it in
+// the hot paths. Messages go to stderr unless the application installs a sink.
+using EngineLogSink = void (*)(const char* message);
+
+void setEngineLogSink(EngineLogSink sink);
+void engineLog(const char* format, ...); // printf-style, no trailing newline
+
+#ifdef SUDOKU_ENGINE_LOGGING
+#define ENGINE_LOG(...) engineLog(__VA_ARGS__)
+#else
+#define ENGINE_LOG(...) ((void)0)
+#endif
+
+#endif // ENGINELOG_H
@@ -1,7 +1,12 @@
 #include "gamestate.h"
 
+#include <algorithm>
+
 GameState::GameState() {
     saveFilePath = getSaveFilePath();
+    autosaveFilePath = getAutosaveFilePath();
+    journalFilePath = getJournalFilePath();
+    legacySaveFilePath = getLegacySaveFilePath();
 }
 
 QString GameState::getSaveFilePath() {
@@ -10,137 +15,230 @@ QString GameState::getSaveFilePath() {
     if (!dir.exists()) {
         dir.mkpath(".");
     }
+    return appDataPath + "/sudoku_save.dat";
+}
+
+QString GameState::getAutosaveFilePath() {
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return appDataPath + "/sudoku_autosave.dat";
+}
+
+QString GameState::getJournalFilePath() {
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    return appDataPath + "/sudoku_autosave.journal";
+}
+
+QString GameState::getLegacySaveFilePath() {
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
     return appDataPath + "/sudoku_save.json";
 }
 
 bool GameState::hasSavedGame() {
     QFile file(saveFilePath);
-    return file.exists() && file.size() > 0;
+    if (file.exists() && file.size() > 0) return true;
+
+    QFile autosaveFile(autosaveFilePath);
+    if (autosaveFile.exists() && autosaveFile.size() > 0) return true;
+
+    QFile legacyFile(legacySaveFilePath);
+    return legacyFile.exists() && legacyFile.size() > 0;
+}
+
+SaveData GameState::makeSaveData(const int board[BOARD_SIZE][BOARD_SIZE], const int solution[BOARD_SIZE][BOARD_SIZE], const int userInputs[BOARD_SIZE][BOARD_SIZE], const uint16_t notes[BOARD_SIZE][BOARD_SIZE], const MoveHistory& history, uint64_t seed) {
+    SaveData save;
+    std::copy(&board[0][0], &board[0][0] + BOARD_SIZE * BOARD_SIZE, &save.board[0][0]);
+    std::copy(&solution[0][0], &solution[0][0] + BOARD_SIZE * BOARD_SIZE, &save.solution[0][0]);
+    std::copy(&userInputs[0][0], &userInputs[0][0] + BOARD_SIZE * BOARD_SIZE, &save.userInputs[0][0]);
+    std::copy(&notes[0][0], &notes[0][0] + BOARD_SIZE * BOARD_SIZE, &save.notes[0][0]);
+    save.history = history;
+    save.seed = seed;
+    return save;
 }
 
-bool GameState::saveGame(int board[BOARD_SIZE][BOARD_SIZE], int solution[BOARD_SIZE][BOARD_SIZE], QLineEdit* cells[BOARD_SIZE][BOARD_SIZE]) {
+bool GameState::saveGame(const int board[BOARD_SIZE][BOARD_SIZE], const int solution[BOARD_SIZE][BOARD_SIZE], const int userInputs[BOARD_SIZE][BOARD_SIZE], const uint16_t notes[BOARD_SIZE][BOARD_SIZE], const MoveHistory& history, uint64_t seed) {
     qDebug() << "Saving game...";
-    QJsonObject gameState;
-
-	// Save board
-    QJsonArray boardArray;
-    for (int row = 0; row < BOARD_SIZE; row++) {
-        QJsonArray rowArray;
-        for (int col = 0; col < BOARD_SIZE; col++) {
-            rowArray.append(board[row][col]);
-        }
-        boardArray.append(rowArray);
-    }
-    gameState["board"] = boardArray;
-
-	// Save solution
-    QJsonArray solutionArray;
-    for (int row = 0; row < BOARD_SIZE; row++) {
-        QJsonArray rowArray;
-        for (int col = 0; col < BOARD_SIZE; col++) {
-            rowArray.append(solution[row][col]);
-        }
-        solutionArray.append(rowArray);
+    SaveData save = makeSaveData(board, solution, userInputs, notes, history, seed);
+
+    uint32_t checksum;
+    if (!writeSaveFile(saveFilePath, save, checksum)) return false;
+
+    // The binary save supersedes any JSON save from older versions
+    QFile::remove(legacySaveFilePath);
+    qDebug() << "Game saved to" << saveFilePath;
+
+    // Further moves are journaled against the state just saved
+    return writeSnapshot(save);
+}
+
+bool GameState::autosaveGame(const int board[BOARD_SIZE][BOARD_SIZE], const int solution[BOARD_SIZE][BOARD_SIZE], const int userInputs[BOARD_SIZE][BOARD_SIZE], const uint16_t notes[BOARD_SIZE][BOARD_SIZE], const MoveHistory& history, uint64_t seed) {
+    return writeSnapshot(makeSaveData(board, solution, userInputs, notes, history, seed));
+}
+
+bool GameState::writeSaveFile(const QString& path, const SaveData& save, uint32_t& checksum) {
+    uint8_t data[SAVE_FILE_MAX_BYTES];
+    int size = encodeSave(save, data);
+    checksum = saveChecksum(data, size);
+
+    // QSaveFile only replaces the old file once the new one is fully written
+    QSaveFile file(path);
+    if (!file.open(QIODevice::WriteOnly)
+        || file.write(reinterpret_cast<const char*>(data), size) != size
+        || !file.commit()) {
+        qDebug() << "Error saving game to" << path << ":" << file.errorString();
+        return false;
     }
-    gameState["solution"] = solutionArray;
-
-    // Save inputs
-    QJsonArray userInputsArray;
-    for (int row = 0; row < BOARD_SIZE; row++) {
-        QJsonArray rowArray;
-        for (int col = 0; col < BOARD_SIZE; col++) {
-            int value = 0;
-            if (!cells[row][col]->isReadOnly()) {
-                QString text = cells[row][col]->text();
-                if (!text.isEmpty()) {
-                    bool ok;
-                    value = text.toInt(&ok);
-                    if (!ok) value = 0;
-                }
-            }
-            rowArray.append(value);
-        }
-        userInputsArray.append(rowArray);
+    return true;
+}
+
+// Writes the autosave snapshot and starts a fresh journal tied to it
+bool GameState::writeSnapshot(const SaveData& save) {
+    uint32_t checksum;
+    if (!writeSaveFile(autosaveFilePath, save, checksum)) return false;
+
+    closeJournal();
+    journalFile.setFileName(journalFilePath);
+    if (!journalFile.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+        qDebug() << "Could not open move journal:" << journalFile.errorString();
+        return false;
     }
-    gameState["userInputs"] = userInputsArray;
+    uint8_t header[JOURNAL_HEADER_BYTES];
+    encodeJournalHeader(checksum, header);
+    journalFile.write(reinterpret_cast<const char*>(header), JOURNAL_HEADER_BYTES);
+    journalFile.flush();
 
-    // Save timestamp
-    gameState["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+    journalState = save;
+    journalMoves = 0;
+    return true;
+}
 
-    // Save to file
-    QJsonDocument doc(gameState);
-    QFile file(saveFilePath);
-    if (file.open(QIODevice::WriteOnly)) {
-        file.write(doc.toJson());
-        file.close();
-        qDebug() << "Game saved to" << saveFilePath;
-        return true;
+bool GameState::journalActive() const {
+    return journalFile.isOpen();
+}
+
+bool GameState::appendMove(JournalEntryType type, int row, int col, int value) {
+    if (!journalActive()) return false;
+
+    uint8_t record[JOURNAL_RECORD_BYTES];
+    encodeJournalRecord(type, row * BOARD_SIZE + col, value, record);
+    applyJournalRecord(record, journalState);
+
+    if (++journalMoves >= COMPACT_AFTER_MOVES) {
+        return writeSnapshot(journalState);
     }
-    else {
-        qDebug() << "Error saving game to" << saveFilePath << ":" << file.errorString();
+
+    // One small append per move, flushed so a crash loses at most the move in flight
+    if (journalFile.write(reinterpret_cast<const char*>(record), JOURNAL_RECORD_BYTES) != JOURNAL_RECORD_BYTES) {
+        qDebug() << "Error appending to move journal:" << journalFile.errorString();
         return false;
     }
+    return journalFile.flush();
 }
 
-bool GameState::loadGame(int board[BOARD_SIZE][BOARD_SIZE], int solution[BOARD_SIZE][BOARD_SIZE], QJsonObject& gameState) {
-    if (!hasSavedGame()) {
-        qDebug() << "No saved game file found at" << saveFilePath;
+void GameState::closeJournal() {
+    if (journalFile.isOpen()) journalFile.close();
+}
+
+void GameState::discardAutosave() {
+    closeJournal();
+    QFile::remove(autosaveFilePath);
+    QFile::remove(journalFilePath);
+    qDebug() << "Autosaved moves discarded, the save slot is kept";
+}
+
+bool GameState::loadBinary(const QString& path, SaveData& save, uint32_t& checksum) {
+    QFile file(path);
+    if (!file.exists()) return false;
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Could not open saved game file:" << file.errorString();
         return false;
     }
 
-    QFile file(saveFilePath);
+    // One read into a fixed buffer, no parsing allocations
+    uint8_t data[SAVE_FILE_MAX_BYTES];
+    qint64 bytesRead = file.read(reinterpret_cast<char*>(data), SAVE_FILE_MAX_BYTES);
+    file.close();
+
+    if (!decodeSave(data, bytesRead, save, &checksum)) {
+        qDebug() << "Invalid or corrupted save file" << path;
+        return false;
+    }
+    return true;
+}
+
+// An autosave older than the save slot is left over from before the last explicit
+// save. Saving restarts the autosave right after the slot, so one continuing the slot
+// is never older.
+bool GameState::autosaveIsCurrent() const {
+    QFileInfo autosave(autosaveFilePath);
+    QFileInfo slot(saveFilePath);
+    if (!autosave.exists()) return false;
+    return !slot.exists() || autosave.lastModified() >= slot.lastModified();
+}
+
+bool GameState::loadLegacyJson(SaveData& save) {
+    QFile file(legacySaveFilePath);
+    if (!file.exists()) return false;
     if (!file.open(QIODevice::ReadOnly)) {
         qDebug() << "Could not open saved game file:" << file.errorString();
         return false;
     }
 
+    QByteArray data = file.readAll();
+    file.close();
+    return decodeLegacyJson(data, save);
+}
+
+int GameState::replayJournal(SaveData& save, uint32_t snapshotChecksum) {
+    QFile file(journalFilePath);
+    if (!file.open(QIODevice::ReadOnly)) return 0;
     QByteArray data = file.readAll();
     file.close();
 
-    QJsonDocument doc = QJsonDocument::fromJson(data);
-    if (doc.isNull() || !doc.isObject()) {
-        qDebug() << "Invalid JSON format in save file.";
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data.constData());
+    uint32_t journalChecksum;
+    if (!decodeJournalHeader(bytes, data.size(), journalChecksum) || journalChecksum != snapshotChecksum) {
+        qDebug() << "Move journal does not belong to the saved snapshot, ignoring it";
+        return 0;
+    }
+
+    int moves = 0;
+    for (qint64 offset = JOURNAL_HEADER_BYTES; offset + JOURNAL_RECORD_BYTES <= data.size(); offset += JOURNAL_RECORD_BYTES) {
+        if (!applyJournalRecord(bytes + offset, save)) break;
+        moves++;
+    }
+    return moves;
+}
+
+bool GameState::loadGame(int board[BOARD_SIZE][BOARD_SIZE], int solution[BOARD_SIZE][BOARD_SIZE], int userInputs[BOARD_SIZE][BOARD_SIZE], uint16_t notes[BOARD_SIZE][BOARD_SIZE], MoveHistory& history, uint64_t& seed) {
+    if (!hasSavedGame()) {
+        qDebug() << "No saved game file found at" << saveFilePath;
         return false;
     }
 
-    gameState = doc.object();
-
-    // Load board state (original puzzle)
-    if (gameState.contains("board") && gameState["board"].isArray()) {
-        QJsonArray boardArray = gameState["board"].toArray();
-        if (boardArray.size() == BOARD_SIZE) {
-            for (int row = 0; row < BOARD_SIZE; row++) {
-                if (boardArray[row].isArray() && boardArray[row].toArray().size() == BOARD_SIZE) {
-                    QJsonArray rowArray = boardArray[row].toArray();
-                    for (int col = 0; col < BOARD_SIZE; col++) {
-                        board[row][col] = rowArray[col].toInt(0); // Default to 0 if invalid
-                    }
-                }
-                else { qDebug() << "Invalid row array size in saved board"; return false; }
-            }
-        }
-        else { qDebug() << "Invalid board array size in save file"; return false; }
+    SaveData save;
+    uint32_t checksum = 0;
+    if (autosaveIsCurrent() && loadBinary(autosaveFilePath, save, checksum)) {
+        int moves = replayJournal(save, checksum);
+        qDebug() << "Game data loaded successfully from" << autosaveFilePath << "with" << moves << "journaled moves";
+    }
+    else if (loadBinary(saveFilePath, save, checksum)) {
+        qDebug() << "Game data loaded successfully from" << saveFilePath;
     }
-    else { qDebug() << "Missing or invalid 'board' array in save file"; return false; }
-
-    // Load solution
-    if (gameState.contains("solution") && gameState["solution"].isArray()) {
-        QJsonArray solutionArray = gameState["solution"].toArray();
-        if (solutionArray.size() == BOARD_SIZE) {
-            for (int row = 0; row < BOARD_SIZE; row++) {
-                if (solutionArray[row].isArray() && solutionArray[row].toArray().size() == BOARD_SIZE) {
-                    QJsonArray rowArray = solutionArray[row].toArray();
-                    for (int col = 0; col < BOARD_SIZE; col++) {
-                        solution[row][col] = rowArray[col].toInt(0);
-                    }
-                }
-                else { qDebug() << "Invalid row array size in saved solution"; return false; }
-            }
-        }
-        else { qDebug() << "Invalid solution array size in save file"; return false; }
+    else if (loadLegacyJson(save)) {
+        qDebug() << "Game data migrated from" << legacySaveFilePath;
     }
-    else { qDebug() << "Missing or invalid 'solution' array in save file"; return false; }
+    else {
+        return false;
+    }
+
+    std::copy(&save.board[0][0], &save.board[0][0] + BOARD_SIZE * BOARD_SIZE, &board[0][0]);
+    std::copy(&save.solution[0][0], &save.solution[0][0] + BOARD_SIZE * BOARD_SIZE, &solution[0][0]);
+    std::copy(&save.userInputs[0][0], &save.userInputs[0][0] + BOARD_SIZE * BOARD_SIZE, &userInputs[0][0]);
+    std::copy(&save.notes[0][0], &save.notes[0][0] + BOARD_SIZE * BOARD_SIZE, &notes[0][0]);
+    history = save.history;
+    seed = save.seed;
 
-    qDebug() << "Game data loaded successfully from" << saveFilePath;
+    // Compact into the autosave right away so further moves append to a fresh journal
+    writeSnapshot(save);
     return true;
 }
@@ -4,33 +4,70 @@
 
 #include <QString>
 #include <QFile>
-#include <QJsonDocument>
-#include <QJsonObject>
-#include <QJsonArray>
-#include <QDateTime>
+#include <QFileInfo>
+#include <QSaveFile>
 #include <QStandardPaths>
 #include <QDir>
 #include <QDebug>
-#include <QLineEdit>
 
-const int BOARD_SIZE = 9;
+#include "boardsize.h"
+#include "savefile.h"
+
+const int BOARD_SIZE = ClassicBoard::N;
 
 class GameState {
 public:
     GameState();
 
-    // Save/Load functions
-    bool saveGame(int board[BOARD_SIZE][BOARD_SIZE], int solution[BOARD_SIZE][BOARD_SIZE],
-        QLineEdit* cells[BOARD_SIZE][BOARD_SIZE]);
+    // Save/Load functions. Saving writes the save slot and restarts the autosave from it.
+    // Loading prefers the autosave, its snapshot plus the journal replayed on top, when it
+    // is at least as new as the save slot, and falls back to the save slot otherwise.
+    bool saveGame(const int board[BOARD_SIZE][BOARD_SIZE], const int solution[BOARD_SIZE][BOARD_SIZE],
+        const int userInputs[BOARD_SIZE][BOARD_SIZE], const uint16_t notes[BOARD_SIZE][BOARD_SIZE],
+        const MoveHistory& history, uint64_t seed);
     bool loadGame(int board[BOARD_SIZE][BOARD_SIZE], int solution[BOARD_SIZE][BOARD_SIZE],
-        QJsonObject& gameState);
+        int userInputs[BOARD_SIZE][BOARD_SIZE], uint16_t notes[BOARD_SIZE][BOARD_SIZE],
+        MoveHistory& history, uint64_t& seed);
+
+    // Autosave: a snapshot and a move journal in their own files, the save slot is never touched
+    bool autosaveGame(const int board[BOARD_SIZE][BOARD_SIZE], const int solution[BOARD_SIZE][BOARD_SIZE],
+        const int userInputs[BOARD_SIZE][BOARD_SIZE], const uint16_t notes[BOARD_SIZE][BOARD_SIZE],
+        const MoveHistory& history, uint64_t seed);
+    bool journalActive() const;
+    bool appendMove(JournalEntryType type, int row, int col, int value);
+    void closeJournal();
+    // Drops everything autosaved since the last explicit save. Called on Discard and
+    // when a game ends, so Continue goes back to the save slot.
+    void discardAutosave();
 
     // Helper functions
     QString getSaveFilePath();
+    QString getAutosaveFilePath();
+    QString getJournalFilePath();
+    QString getLegacySaveFilePath();
     bool hasSavedGame();
 
 private:
+    static const int COMPACT_AFTER_MOVES = 128;
+
+    static SaveData makeSaveData(const int board[BOARD_SIZE][BOARD_SIZE], const int solution[BOARD_SIZE][BOARD_SIZE],
+        const int userInputs[BOARD_SIZE][BOARD_SIZE], const uint16_t notes[BOARD_SIZE][BOARD_SIZE],
+        const MoveHistory& history, uint64_t seed);
+    static bool writeSaveFile(const QString& path, const SaveData& save, uint32_t& checksum);
+    bool writeSnapshot(const SaveData& save);
+    bool loadBinary(const QString& path, SaveData& save, uint32_t& checksum);
+    bool autosaveIsCurrent() const;
+    bool loadLegacyJson(SaveData& save);
+    int replayJournal(SaveData& save, uint32_t snapshotChecksum);
+
     QString saveFilePath;
+    QString autosaveFilePath;
+    QString journalFilePath;
+    QString legacySaveFilePath;
+
+    QFile journalFile;
+    SaveData journalState;   // snapshot plus every appended move, used for compaction
+    int journalMoves = 0;
 };
 
 #endif // GAMESTATE_H
@@ -0,0 +1,56 @@
+#include "hintengine.h"
+
+namespace {
+
+const int N = ClassicBoard::N;
+
+const BoardTables<3>& tables = CLASSIC_TABLES;
+
+bool isWrong(const BoardModel& board, int row, int col) {
+    int value = board.value(row, col);
+    if (value == 0 || board.isGiven(row, col)) return false;
+    int solution = board.solutionValue(row, col);
+    return solution != 0 ? value != solution : board.hasConflict(row, col);
+}
+
+} // namespace
+
+Hint HintEngine::next(const BoardModel& board) {
+    Hint hint;
+
+    // --- Wrong entries ---
+    for (int cell = 0; cell < ClassicBoard::CELLS; ++cell) {
+        if (!isWrong(board, cell / N, cell % N)) continue;
+        hint.kind = Hint::Kind::WrongEntry;
+        hint.cell = cell;
+        hint.highlights[hint.highlightCount++] = static_cast<uint8_t>(cell);
+        return hint;
+    }
+
+    // --- Next deduction ---
+    hint.step = grader.nextStep(board.values());
+    hint.cell = hint.step.cell;
+    switch (hint.step.technique) {
+    case Technique::HiddenSingle:
+        hint.kind = Hint::Kind::Deduction;
+        hint.digit = hint.step.digit;
+        for (uint8_t cell : tables.units[hint.step.unit]) hint.highlights[hint.highlightCount++] = cell;
+        break;
+    case Technique::NakedSingle:
+        hint.kind = Hint::Kind::Deduction;
+        hint.digit = hint.step.digit;
+        for (uint8_t peer : tables.peers[hint.cell]) {
+            if (board.value(peer / N, peer % N) != 0) hint.highlights[hint.highlightCount++] = peer;
+        }
+        break;
+    case Technique::Guessing:
+        hint.digit = board.solutionValue(hint.cell / N, hint.cell % N);
+        if (hint.digit == 0) break; // nothing to reveal without a solution
+        hint.kind = Hint::Kind::Reveal;
+        hint.highlights[hint.highlightCount++] = static_cast<uint8_t>(hint.cell);
+        break;
+    default:
+        break;
+    }
+    return hint;
+}
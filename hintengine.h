@@ -0,0 +1,43 @@
+#pragma once
+#ifndef HINTENGINE_H
+#define HINTENGINE_H
+
+#include <cstdint>
+
+#include "boardmodel.h"
+#include "boardtables.h"
+#include "puzzlegrader.h"
+
+struct Hint {
+    enum class Kind : uint8_t {
+        None,       // board full, or no solution to check against and nothing deducible
+        WrongEntry, // cell holds a digit that does not belong there, digit is 0
+        Deduction,  // a single on the player's board, step says which
+        Reveal      // logic is stuck, digit comes from the solution
+    };
+    static const int MAX_HIGHLIGHTS = BoardTables<3>::PEERS;
+
+    Kind kind = Kind::None;
+    int cell = -1;
+    int digit = 0;  // what the cell should hold
+    PuzzleStep step;
+
+    // Cells that explain the hint: the unit of a hidden single, the filled
+    // peers that rule out every other digit of a naked single
+    uint8_t highlights[MAX_HIGHLIGHTS];
+    int highlightCount = 0;
+};
+
+// Picks what the Hint button shows: a wrong entry first, since no deduction
+// from it can be trusted, otherwise the easiest logical placement on the
+// board as the player has it. Uses the bitmask grader, so a hint takes
+// microseconds.
+class HintEngine {
+public:
+    Hint next(const BoardModel& board);
+
+private:
+    PuzzleGrader grader;
+};
+
+#endif // HINTENGINE_H
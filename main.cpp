@@ -1,11 +1,19 @@
 #include "mainwindow.h"
 #include "mainmenu.h"
+#include "enginelog.h"
 
 #include <QApplication>
+#include <QDebug>
+
+static void engineLogToQt(const char* message)
+{
+    qDebug().noquote() << message;
+}
 
 int main(int argc, char* argv[])
 {
     QApplication a(argc, argv);
+    setEngineLogSink(engineLogToQt);
     MainMenu menu;
     menu.show();;
     return a.exec();
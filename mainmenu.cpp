@@ -2,10 +2,15 @@
 #include "mainwindow.h"
 #include "difficultydialog.h"
 #include "instructionsdialog.h"
+#include "puzzlequeue.h"
+#include "gamestate.h"
 
 MainMenu::MainMenu(QWidget* parent) : QWidget(parent)
 {
     setupUI();
+    // Start filling the puzzle queue while the player is still in the menu
+    puzzleQueue = new PuzzleQueue(this);
+
     // Check if saved game exists and enable/disable continue button
     btnContinueGame->setEnabled(hasSavedGame());
 
@@ -98,13 +103,13 @@ void MainMenu::startNewGame() {
     }
 
     if (difficultyDialog->exec() == QDialog::Accepted) {
-        int mode = difficultyDialog->getSelectedMode(); // 0: Custom, 1: Easy, 2: Medium, 3: Hard
+        int mode = difficultyDialog->getSelectedMode(); // 0: Custom, 1: Easy, 2: Medium, 3: Hard, 4: Expert
 
         if (gameWindow) {
             gameWindow->close();
             delete gameWindow;   // Delete properly
         }
-        gameWindow = new MainWindow(mode);
+        gameWindow = new MainWindow(mode, puzzleQueue);
 
         connect(gameWindow, &MainWindow::gameClosed, this, &MainMenu::handleGameFinished);
 
@@ -118,7 +123,7 @@ void MainMenu::continueGame() {
         gameWindow->close();
         delete gameWindow;
     }
-    gameWindow = new MainWindow(MainWindow::Mode::Continue);
+    gameWindow = new MainWindow(MainWindow::Mode::Continue, puzzleQueue);
 
     connect(gameWindow, &MainWindow::gameClosed, this, &MainMenu::handleGameFinished);
     
@@ -147,16 +152,6 @@ void MainMenu::handleGameFinished() {
     this->show(); 
 }
 
-QString MainMenu::getSaveFilePath() {
-    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
-    QDir dir(appDataPath);
-    if (!dir.exists()) {
-        dir.mkpath(".");
-    }
-    return appDataPath + "/sudoku_save.json";
-}
-
 bool MainMenu::hasSavedGame() {
-    QFile file(getSaveFilePath());
-    return file.exists() && file.size() > 0;
+    return GameState().hasSavedGame();
 }
\ No newline at end of file
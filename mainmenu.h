@@ -15,6 +15,7 @@
 class MainWindow;
 class DifficultyDialog;
 class InstructionsDialog;
+class PuzzleQueue;
 
 class MainMenu : public QWidget
 {
@@ -34,7 +35,6 @@ private slots:
 private:
     void setupUI();
     bool hasSavedGame();
-    QString getSaveFilePath();
 
     QLabel* titleLabel;
     QPushButton* btnNewGame;
@@ -45,6 +45,7 @@ private:
     MainWindow* gameWindow = nullptr;
     DifficultyDialog* difficultyDialog = nullptr;
     InstructionsDialog* instructionsDialog = nullptr;
+    PuzzleQueue* puzzleQueue = nullptr; // shared by every game window, generates in the background
 };
 
 #endif // MAINMENU_H
@@ -1,25 +1,23 @@
 ﻿#include "mainwindow.h"
 #include "mainmenu.h"
+#include "boardtables.h"
 
 #include <QApplication>
 #include <QMessageBox>
 #include <QPushButton>
-#include <QLineEdit>
 #include <QLabel>
-#include <QGridLayout>
 #include <QGroupBox>
 #include <QFrame>
-#include <QIntValidator>
 #include <QDebug>
 #include <vector> 
 #include <random> 
 #include <algorithm>
 
 // --- Constructor for New Game / Custom ---
-MainWindow::MainWindow(int modeValue, QWidget* parent) : QMainWindow(parent), sudokuLogic(), gameState(), uiHelper()
+MainWindow::MainWindow(int modeValue, PuzzleQueue* puzzleQueue, QWidget* parent) : QMainWindow(parent), sudokuLogic(), gameState(), uiHelper(), puzzleQueue(puzzleQueue)
 {
     currentMode = (modeValue == 0) ? Mode::Custom : Mode::NewGame;
-    initialDifficulty = (modeValue >= 1 && modeValue <= 3) ? modeValue : 2;
+    initialDifficulty = (modeValue >= 1 && modeValue <= 4) ? modeValue : 2;
     isCustomMode = (currentMode == Mode::Custom);
 
     setupUI();
@@ -33,7 +31,7 @@ MainWindow::MainWindow(int modeValue, QWidget* parent) : QMainWindow(parent), su
 }
 
 // --- Constructor for Continue Game ---
-MainWindow::MainWindow(Mode mode, QWidget* parent) : QMainWindow(parent), sudokuLogic(), gameState(), uiHelper()
+MainWindow::MainWindow(Mode mode, PuzzleQueue* puzzleQueue, QWidget* parent) : QMainWindow(parent), sudokuLogic(), gameState(), uiHelper(), puzzleQueue(puzzleQueue)
 {
     Q_ASSERT(mode == Mode::Continue);
     currentMode = Mode::Continue;
@@ -60,18 +58,12 @@ void MainWindow::setupUI() {
         QWidget#centralWidget { background-color: #f0eadd; }
         QGroupBox { font-family: "Garamond", serif; font-size: 16px; font-weight: bold; color: #5a4d41; border: 1px solid #d3c5b4; margin-top: 1ex; background-color: #e6dbc8; padding: 15px; border-radius: 0px; }
         QGroupBox::title { subcontrol-origin: margin; subcontrol-position: top left; padding: 0 3px; left: 10px; background-color: #e6dbc8; }
-        QLineEdit { background-color: #ffffff; border: 1px solid #cccccc; font-size: 20px; font-weight: bold; color: #333333; border-radius: 0px; min-width: 30px; min-height: 30px; }
-        QLineEdit[readOnly="true"] { background-color: #e6dbc8; color: #5a4d41; font-weight: bold; border: 1px solid #b0a593; }
-        QLineEdit.correct { background-color: #e0ffe0; color: #006400; }
-        QLineEdit.incorrect { background-color: #ffe0e0; color: #a00000; }
-        QLineEdit.solution { background-color: #f0f8ff; color: #4682b4; }
         QPushButton { background-color: #d2b48c; color: #4b3832; border: 1px solid #8b7e66; padding: 8px 12px; border-radius: 3px; font-family: "Garamond", serif; font-size: 14px; min-width: 100px; }
         QPushButton:hover { background-color: #c1a37c; }
-        QPushButton:pressed { background-color: #a08a6c; }
+        QPushButton:pressed, QPushButton:checked { background-color: #a08a6c; }
         QPushButton:disabled { background-color: #e0d8cd; color: #888888; border-color: #c0b8ae; }
         QLabel#statusLabel { font-size: 14px; color: #4b3832; font-family: "Garamond", serif; font-weight: bold; margin-top: 10px; background-color: #e6dbc8; padding: 5px; border: 1px solid #d3c5b4; }
-        QFrame#blockFrame { border: 2px solid #5a4d41; border-radius: 0px; background-color: transparent; }
-        QFrame#sudokuFrame { border: 3px solid #3a2d21; background-color: #f0eadd; padding: 3px; }
+        QFrame#sudokuFrame { background-color: #f0eadd; padding: 3px; }
     )");
 
     QHBoxLayout* mainLayout = new QHBoxLayout(centralWidget);
@@ -82,42 +74,11 @@ void MainWindow::setupUI() {
     sudokuFrame->setObjectName("sudokuFrame");
     QVBoxLayout* sudokuFrameLayout = new QVBoxLayout(sudokuFrame);
 
-    QGridLayout* mainGridLayout = new QGridLayout;
-    mainGridLayout->setSpacing(0);
-    mainGridLayout->setContentsMargins(0, 0, 0, 0);
-
-    for (int blockRow = 0; blockRow < 3; ++blockRow) {
-        for (int blockCol = 0; blockCol < 3; ++blockCol) {
-            QFrame* blockFrame = new QFrame();
-            blockFrame->setObjectName("blockFrame");
-            blockFrame->setFrameShape(QFrame::Box);
-
-            QGridLayout* blockLayout = new QGridLayout(blockFrame);
-            blockLayout->setSpacing(1);
-            blockLayout->setContentsMargins(1, 1, 1, 1);
-
-            for (int row = 0; row < 3; ++row) {
-                for (int col = 0; col < 3; ++col) {
-                    int globalRow = blockRow * 3 + row;
-                    int globalCol = blockCol * 3 + col;
-
-                    cells[globalRow][globalCol] = new QLineEdit(this);
-                    cells[globalRow][globalCol]->setAlignment(Qt::AlignCenter);
-                    cells[globalRow][globalCol]->setMaxLength(1);
-                    cells[globalRow][globalCol]->setFixedSize(40, 40);
-                    cells[globalRow][globalCol]->setValidator(new QIntValidator(1, 9, this));
-
-                    connect(cells[globalRow][globalCol], &QLineEdit::textChanged, this, [this, globalRow, globalCol](const QString&) {
-                        handleCellInput(globalRow, globalCol);
-                    });
-
-                    blockLayout->addWidget(cells[globalRow][globalCol], row, col);
-                }
-            }
-            mainGridLayout->addWidget(blockFrame, blockRow, blockCol);
-        }
-    }
-    sudokuFrameLayout->addLayout(mainGridLayout);
+    // One painted widget for all 81 cells, see boardwidget.h
+    boardWidget = new BoardWidget(sudokuFrame);
+    connect(boardWidget, &BoardWidget::cellChanged, this, &MainWindow::handleCellInput);
+    connect(boardWidget, &BoardWidget::notesChanged, this, &MainWindow::handleNotesInput);
+    sudokuFrameLayout->addWidget(boardWidget, 0, Qt::AlignCenter);
 
     // --- Control Panel Setup ---
     QGroupBox* controlFrame = new QGroupBox("Controls");
@@ -128,6 +89,11 @@ void MainWindow::setupUI() {
     btnHint = uiHelper.createStyledButton("Hint");
     btnSolve = uiHelper.createStyledButton("Show Solution");
     btnReset = uiHelper.createStyledButton("Reset Board");
+    btnUndo = uiHelper.createStyledButton("Undo");
+    btnRedo = uiHelper.createStyledButton("Redo");
+    btnNotes = uiHelper.createStyledButton("Notes (N)");
+    btnNotes->setCheckable(true);
+    btnFillNotes = uiHelper.createStyledButton("Fill Notes");
     btnSaveGame = uiHelper.createStyledButton("Save Game");
     btnBackMenu = uiHelper.createStyledButton("Back to Menu");
 
@@ -135,6 +101,10 @@ void MainWindow::setupUI() {
     controlLayout->addWidget(btnHint);
     controlLayout->addWidget(btnSolve);
     controlLayout->addWidget(btnReset);
+    controlLayout->addWidget(btnUndo);
+    controlLayout->addWidget(btnRedo);
+    controlLayout->addWidget(btnNotes);
+    controlLayout->addWidget(btnFillNotes);
     controlLayout->addWidget(btnSaveGame);
     controlLayout->addStretch(1);
     controlLayout->addWidget(btnBackMenu);
@@ -152,16 +122,39 @@ void MainWindow::setupUI() {
 
     btnValidateCustom->setVisible(isCustomMode);
     btnHint->setEnabled(!isCustomMode);
+    btnFillNotes->setEnabled(!isCustomMode);
     btnSolve->setEnabled(!isCustomMode);
     btnSaveGame->setEnabled(!isCustomMode);
+    btnUndo->setEnabled(false);
+    btnRedo->setEnabled(false);
 
     // Connect button signals to slots
     connect(btnHint, &QPushButton::clicked, this, &MainWindow::giveHint);
     connect(btnReset, &QPushButton::clicked, this, &MainWindow::resetBoard);
+    connect(btnUndo, &QPushButton::clicked, this, &MainWindow::undoMove);
+    connect(btnRedo, &QPushButton::clicked, this, &MainWindow::redoMove);
+    connect(btnNotes, &QPushButton::toggled, boardWidget, &BoardWidget::setNotesMode);
+    connect(boardWidget, &BoardWidget::notesModeChanged, btnNotes, &QPushButton::setChecked);
+    connect(btnFillNotes, &QPushButton::clicked, this, &MainWindow::fillNotes);
     connect(btnSolve, &QPushButton::clicked, this, &MainWindow::showSolution);
     connect(btnValidateCustom, &QPushButton::clicked, this, &MainWindow::validateCustomBoard);
     connect(btnSaveGame, &QPushButton::clicked, this, &MainWindow::saveGame);
     connect(btnBackMenu, &QPushButton::clicked, this, &MainWindow::backToMenu);
+
+    if (puzzleQueue) {
+        connect(puzzleQueue, &PuzzleQueue::puzzleAvailable, this, &MainWindow::onPuzzleAvailable);
+    }
+
+    // Debug overlay with the solver statistics of the current puzzle
+    if (SOLVER_STATS_ENABLED) {
+        statsOverlay = new QLabel(centralWidget);
+        statsOverlay->setStyleSheet("background-color: rgba(40, 30, 20, 200); color: #f0eadd; font-family: monospace; font-size: 11px; padding: 6px;");
+        statsOverlay->setAttribute(Qt::WA_TransparentForMouseEvents);
+        statsOverlay->move(8, 8);
+        statsOverlay->hide();
+        QShortcut* statsShortcut = new QShortcut(QKeySequence(Qt::Key_F12), this);
+        connect(statsShortcut, &QShortcut::activated, this, &MainWindow::toggleStatsOverlay);
+    }
 }
 
 // --- Internal Game Initialization ---
@@ -172,52 +165,98 @@ void MainWindow::generateNewGameInternal(int difficulty) {
 
     for (int i = 0; i < SIZE; ++i) for (int j = 0; j < SIZE; ++j) board[i][j] = solution[i][j] = 0;
 
-    if (!sudokuLogic.generateFullBoard(solution)) {
+    GeneratedPuzzle puzzle;
+    if (puzzleQueue) {
+        if (puzzleQueue->takePuzzle(difficulty, puzzle)) {
+            startGeneratedGame(puzzle);
+            return;
+        }
+
+        // Queue ran dry: wait for the background worker instead of blocking the event loop
+        pendingDifficulty = difficulty;
+        loadBoardModel();
+        uiHelper.updateBoardUI(board, boardWidget, gameInProgress);
+        for (int row = 0; row < SIZE; row++) {
+            for (int col = 0; col < SIZE; col++) {
+                boardWidget->setReadOnly(row, col, true);
+            }
+        }
+        btnValidateCustom->setVisible(false);
+        btnHint->setEnabled(false);
+        btnFillNotes->setEnabled(false);
+        btnSolve->setEnabled(false);
+        btnReset->setEnabled(false);
+        btnSaveGame->setEnabled(false);
+        statusLabel->setText("Generating a new puzzle, please wait...");
+        return;
+    }
+
+    puzzle.difficulty = difficulty;
+    puzzle.seed = sudokuLogic.newSeed();
+    if (!sudokuLogic.generatePuzzle(puzzle.seed, difficulty, puzzle.board, puzzle.solution)) {
         QMessageBox::critical(this, "Error", "Failed to generate a full Sudoku board.");
         backToMenu();
         return;
     }
-    qDebug() << "Full solution generated.";
+    qDebug() << "Puzzle generated from seed" << puzzle.seed;
+    puzzle.stats = sudokuLogic.stats();
 
-    std::copy(&solution[0][0], &solution[0][0] + SIZE * SIZE, &board[0][0]);
-    sudokuLogic.removeNumbers(board, difficulty);
-    qDebug() << "Numbers removed.";
+    startGeneratedGame(puzzle);
+}
 
-    uiHelper.updateBoardUI(board, cells, gameInProgress);
+void MainWindow::startGeneratedGame(const GeneratedPuzzle& puzzle) {
+    pendingDifficulty = 0;
+    puzzleSeed = puzzle.seed;
+    sudokuLogic.seed(puzzleSeed); // hints follow the puzzle seed too
+    showSolverStats(puzzle.stats, puzzle.stats.attempts > 0 ? "generated" : "puzzle bank");
+    std::copy(&puzzle.board[0][0], &puzzle.board[0][0] + SIZE * SIZE, &board[0][0]);
+    std::copy(&puzzle.solution[0][0], &puzzle.solution[0][0] + SIZE * SIZE, &solution[0][0]);
+    moveHistory.clear();
+    updateUndoButtons();
+
+    loadBoardModel();
+    uiHelper.updateBoardUI(board, boardWidget, gameInProgress);
 
     btnValidateCustom->setVisible(false);
     btnHint->setEnabled(true);
+    btnFillNotes->setEnabled(true);
     btnSolve->setEnabled(true);
+    btnReset->setEnabled(true);
     btnSaveGame->setEnabled(true);
 
     QString difficultyText;
-    switch (difficulty) {
+    switch (puzzle.difficulty) {
     case 1: difficultyText = "Easy"; break;
     case 2: difficultyText = "Medium"; break;
     case 3: difficultyText = "Hard"; break;
+    case 4: difficultyText = "Expert"; break;
     default: difficultyText = "Unknown"; break;
     }
     statusLabel->setText("New " + difficultyText + " game started. Fill the empty cells!");
 }
 
+void MainWindow::onPuzzleAvailable(int difficulty) {
+    if (pendingDifficulty == 0 || difficulty != pendingDifficulty) return;
+
+    GeneratedPuzzle puzzle;
+    if (puzzleQueue->takePuzzle(difficulty, puzzle)) {
+        startGeneratedGame(puzzle);
+    }
+}
+
 void MainWindow::startCustomGameInternal() {
     isCustomMode = true;
     gameInProgress = false;
     qDebug() << "Starting custom game setup.";
 
     clearBoardForCustom();
-
-    for (int row = 0; row < SIZE; row++) {
-        for (int col = 0; col < SIZE; col++) {
-            cells[row][col]->setText("");
-            cells[row][col]->setReadOnly(false);
-            uiHelper.applyCellStyle(cells[row][col], "default");
-            cells[row][col]->setProperty("class", "");
-        }
-    }
+    loadBoardModel();
+    puzzleSeed = 0;
+    uiHelper.updateBoardUI(board, boardWidget, gameInProgress);
 
     btnValidateCustom->setVisible(true);
     btnHint->setEnabled(false);
+    btnFillNotes->setEnabled(false);
     btnSolve->setEnabled(false);
     btnSaveGame->setEnabled(false);
 
@@ -229,39 +268,51 @@ void MainWindow::continueGameInternal() {
     gameInProgress = false;
     qDebug() << "Attempting to continue saved game.";
 
-    QJsonObject loadedGameState;
-    if (!gameState.loadGame(board, solution, loadedGameState)) {
+    int userInputs[SIZE][SIZE] = { 0 };
+    uint16_t userNotes[SIZE][SIZE] = { { 0 } };
+    if (!gameState.loadGame(board, solution, userInputs, userNotes, moveHistory, puzzleSeed)) {
         QMessageBox::warning(this, "Load Error", "Could not load the saved game. Starting a new Medium game.");
         generateNewGameInternal(2);
         return;
     }
+    if (puzzleSeed != 0) sudokuLogic.seed(puzzleSeed);
 
-    uiHelper.updateBoardUI(board, cells, gameInProgress);
+    loadBoardModel();
+    uiHelper.updateBoardUI(board, boardWidget, gameInProgress);
 
-    if (loadedGameState.contains("userInputs") && loadedGameState["userInputs"].isArray()) {
-        QJsonArray userInputsArray = loadedGameState["userInputs"].toArray();
-        for (int row = 0; row < SIZE; row++) {
-            if (row < userInputsArray.size()) {
-                QJsonArray rowArray = userInputsArray[row].toArray();
-                for (int col = 0; col < SIZE; col++) {
-                    if (col < rowArray.size()) {
-                        int value = rowArray[col].toInt();
-                        if (board[row][col] == 0 && value != 0) {
-                            cells[row][col]->setText(QString::number(value));
-                        }
-                        else if (board[row][col] == 0 && value == 0) {
-                            cells[row][col]->setText("");
-                        }
-                    }
-                }
+    // The player's entries go in as one more batch, styled as if they had just been typed
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            if (board[row][col] == 0 && userInputs[row][col] != 0) {
+                boardModel.setValue(row, col, userInputs[row][col]);
+                gameInProgress = true;
+            }
+        }
+    }
+    solvability.load(boardModel.values(), solution);
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            boardModel.setNotes(row, col, userNotes[row][col]);
+        }
+    }
+    boardWidget->beginBatch();
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            if (board[row][col] == 0 && userInputs[row][col] != 0) {
+                boardWidget->setValue(row, col, userInputs[row][col]);
+                boardWidget->setCellStyle(row, col, entryStyle(row, col));
             }
+            boardWidget->setNotes(row, col, boardModel.notes(row, col));
         }
     }
+    boardWidget->endBatch();
 
     btnValidateCustom->setVisible(false);
     btnHint->setEnabled(true);
+    btnFillNotes->setEnabled(true);
     btnSolve->setEnabled(true);
     btnSaveGame->setEnabled(true);
+    updateUndoButtons();
 
     statusLabel->setText("Game loaded successfully. Continue playing!");
 }
@@ -271,99 +322,106 @@ void MainWindow::continueGameInternal() {
 void MainWindow::giveHint() {
     if (isCustomMode) return;
 
-    std::vector<std::pair<int, int>> emptyEditableCells;
-    for (int row = 0; row < SIZE; row++) {
-        for (int col = 0; col < SIZE; col++) {
-            if (board[row][col] == 0 && cells[row][col]->text().isEmpty()) {
-                emptyEditableCells.emplace_back(row, col);
-            }
-        }
+    // A second press carries out the hint on show, handleCellInput then clears it
+    if (shownHint.kind != Hint::Kind::None) {
+        int row = shownHint.cell / SIZE, col = shownHint.cell % SIZE;
+        int digit = shownHint.digit;
+        moveSource = JournalEntryType::Hint;
+        boardWidget->setValue(row, col, digit);
+        moveSource = JournalEntryType::CellEdit;
+        if (digit == 0) statusLabel->setText(QString("Cleared cell (%1, %2).").arg(row + 1).arg(col + 1));
+        return;
     }
 
-    if (!emptyEditableCells.empty()) {
-        std::random_device rd;
-        std::mt19937 g(rd());
-        std::shuffle(emptyEditableCells.begin(), emptyEditableCells.end(), g);
-
-        auto [row, col] = emptyEditableCells.front();
-        cells[row][col]->setText(QString::number(solution[row][col]));
-
-        statusLabel->setText(QString("Hint: Cell (%1, %2) is %3").arg(row + 1).arg(col + 1).arg(solution[row][col]));
-        gameInProgress = true;
-    }
-    else {
-        bool full = true;
-        for (int r = 0; r < SIZE; ++r) for (int c = 0; c < SIZE; ++c) if (cells[r][c]->text().isEmpty()) full = false;
+    Hint hint = hintEngine.next(boardModel);
 
-        if (full) {
+    if (hint.kind == Hint::Kind::None) {
+        if (boardModel.filledCount() == SIZE * SIZE) {
             statusLabel->setText("Board is full. Check your answers or reset.");
         }
         else {
-            statusLabel->setText("No more empty cells to give hints for!");
+            statusLabel->setText("No hint found for this board.");
         }
+        return;
+    }
+
+    boardWidget->beginBatch();
+    boardWidget->clearHighlights();
+    for (int i = 0; i < hint.highlightCount; ++i) {
+        boardWidget->setHighlighted(hint.highlights[i] / SIZE, hint.highlights[i] % SIZE, true);
     }
+    boardWidget->endBatch();
+    boardWidget->selectCell(hint.cell / SIZE, hint.cell % SIZE);
+    shownHint = hint;
+
+    QString action = hint.digit == 0 ? "clear it" : "fill it in";
+    statusLabel->setText(describeHint(hint) + QString(" Press Hint again to %1.").arg(action));
 }
 
 void MainWindow::showSolution() {
     if (isCustomMode) return;
 
-
+    clearHint();
+    boardWidget->beginBatch();
     for (int row = 0; row < SIZE; row++) {
         for (int col = 0; col < SIZE; col++) {
             if (board[row][col] == 0) {
-                cells[row][col]->setText(QString::number(solution[row][col]));
-                uiHelper.applyCellStyle(cells[row][col], "solution");
-                cells[row][col]->setReadOnly(true);
-            }
-            else {
-                uiHelper.applyCellStyle(cells[row][col], "readonly");
+                boardModel.setValue(row, col, solution[row][col]);
+                boardWidget->setReadOnly(row, col, true);
+                boardWidget->setValue(row, col, solution[row][col]);
+                boardWidget->setCellStyle(row, col, CellStyle::Solution);
             }
         }
     }
+    boardWidget->endBatch();
 
     statusLabel->setText("Showing the solution. Start a new game to play again.");
     gameInProgress = false;
+    if (gameState.journalActive()) gameState.discardAutosave(); // Continue returns to the save slot
     btnHint->setEnabled(false);
+    btnFillNotes->setEnabled(false);
     btnSaveGame->setEnabled(false);
     btnReset->setEnabled(false); 
     btnSolve->setEnabled(false);
+    btnUndo->setEnabled(false);
+    btnRedo->setEnabled(false);
 }
 
 void MainWindow::resetBoard() {
     qDebug() << "Resetting board. Custom mode:" << isCustomMode;
+    // board holds only the givens (none in custom mode), so reloading it clears every entry
+    loadBoardModel();
+    uiHelper.updateBoardUI(board, boardWidget, gameInProgress);
     if (isCustomMode) {
-        for (int row = 0; row < SIZE; row++) {
-            for (int col = 0; col < SIZE; col++) {
-                cells[row][col]->setText("");
-                uiHelper.applyCellStyle(cells[row][col], "default");
-                cells[row][col]->setProperty("class", "");
-            }
-        }
         statusLabel->setText("Custom board input cleared.");
     }
     else {
-        for (int row = 0; row < SIZE; row++) {
-            for (int col = 0; col < SIZE; col++) {
-                if (board[row][col] == 0) {
-                    cells[row][col]->setText("");
-                    uiHelper.applyCellStyle(cells[row][col], "default");
-                    cells[row][col]->setProperty("class", "");
-                }
-                else {
-                    uiHelper.applyCellStyle(cells[row][col], "readonly");
-                }
-            }
-        }
+        recordMove(JournalEntryType::Reset, 0, 0, 0, 0);
         statusLabel->setText("Board reset to initial state.");
         gameInProgress = false;
 
         btnHint->setEnabled(true);
+        btnFillNotes->setEnabled(true);
         btnSolve->setEnabled(true);
         btnSaveGame->setEnabled(true);
 
     }
 }
 
+void MainWindow::undoMove() {
+    MoveRecord move;
+    if (isCustomMode || !moveHistory.canUndo()) return;
+    moveHistory.undo(move);
+    applyHistoryMove(JournalEntryType::Undo, move.cell, move.oldValue);
+}
+
+void MainWindow::redoMove() {
+    MoveRecord move;
+    if (isCustomMode || !moveHistory.canRedo()) return;
+    moveHistory.redo(move);
+    applyHistoryMove(JournalEntryType::Redo, move.cell, move.newValue);
+}
+
 void MainWindow::validateCustomBoard() {
     qDebug() << "Validating custom board...";
     int customBoard[SIZE][SIZE] = { 0 };
@@ -371,19 +429,9 @@ void MainWindow::validateCustomBoard() {
 
     for (int row = 0; row < SIZE; row++) {
         for (int col = 0; col < SIZE; col++) {
-            QString text = cells[row][col]->text();
-            if (!text.isEmpty()) {
-                bool ok;
-                int val = text.toInt(&ok);
-                if (ok && val >= 1 && val <= 9) {
-                    customBoard[row][col] = val;
-                    hasInput = true;
-                }
-                else {
-                    QMessageBox::warning(this, "Invalid Input", QString("Invalid value '%1' at row %2, col %3.").arg(text).arg(row + 1).arg(col + 1));
-                    return;
-                }
-            }
+            // The board widget only accepts the digits 1-9
+            customBoard[row][col] = boardWidget->value(row, col);
+            if (customBoard[row][col] != 0) hasInput = true;
         }
     }
     if (!hasInput) {
@@ -391,24 +439,18 @@ void MainWindow::validateCustomBoard() {
         return;
     }
 
-    for (int row = 0; row < SIZE; row++) {
-        for (int col = 0; col < SIZE; col++) {
-            int num = customBoard[row][col];
-            if (num != 0) {
-                int originalValue = customBoard[row][col];
-                customBoard[row][col] = 0;
-                bool placementValid = sudokuLogic.isValid(customBoard, row, col, originalValue);
-                customBoard[row][col] = originalValue;
-                if (!placementValid) {
-                    QMessageBox::warning(this, "Invalid Board", QString("Initial board conflict at row %1, col %2.").arg(row + 1).arg(col + 1));
-                    return;
-                }
-            }
-        }
+    // The vector check clears a valid board at once, only a bad one is scanned for the cell to report
+    int conflictRow, conflictCol;
+    if (!sudokuLogic.isConsistent(customBoard) && sudokuLogic.findConflict(customBoard, conflictRow, conflictCol)) {
+        QMessageBox::warning(this, "Invalid Board", QString("Initial board conflict at row %1, col %2.").arg(conflictRow + 1).arg(conflictCol + 1));
+        return;
     }
     qDebug() << "Initial board conflicts check passed.";
 
-    if (!sudokuLogic.hasUniqueSolution(customBoard, solution)) {
+    sudokuLogic.resetStats();
+    bool unique = sudokuLogic.hasUniqueSolution(customBoard, solution);
+    showSolverStats(sudokuLogic.stats(), "custom board check");
+    if (!unique) {
         QMessageBox::warning(this, "Invalid Board", "Puzzle must have exactly one unique solution.");
         for (int i = 0; i < SIZE; ++i) for (int j = 0; j < SIZE; ++j) solution[i][j] = 0;
         qDebug() << "Unique solution check failed.";
@@ -417,12 +459,14 @@ void MainWindow::validateCustomBoard() {
     qDebug() << "Unique solution check passed.";
 
     std::copy(&customBoard[0][0], &customBoard[0][0] + SIZE * SIZE, &board[0][0]);
-    uiHelper.updateBoardUI(board, cells, gameInProgress);
+    loadBoardModel();
+    uiHelper.updateBoardUI(board, boardWidget, gameInProgress);
 
     isCustomMode = false;
     gameInProgress = false;
     btnValidateCustom->setVisible(false);
     btnHint->setEnabled(true);
+    btnFillNotes->setEnabled(true);
     btnSolve->setEnabled(true);
     btnSaveGame->setEnabled(true);
 
@@ -437,7 +481,7 @@ void MainWindow::saveGame() {
         return;
     }
 
-    if (gameState.saveGame(board, solution, cells)) {
+    if (gameState.saveGame(board, solution, boardModel.values(), boardModel.allNotes(), moveHistory, puzzleSeed)) {
         statusLabel->setText("Game saved successfully!");
         gameInProgress = false;
     }
@@ -458,6 +502,9 @@ void MainWindow::backToMenu() {
         if (reply == QMessageBox::Save) {
             saveGame();
         }
+        else if (reply == QMessageBox::Discard) {
+            if (gameState.journalActive()) gameState.discardAutosave();
+        }
         else if (reply == QMessageBox::Cancel) {
             proceedToClose = false;
         }
@@ -481,9 +528,13 @@ void MainWindow::checkSolution() {
     else {
         QMessageBox::information(this, "Congratulations!", "You solved the puzzle correctly!");
         gameInProgress = false;
+        if (gameState.journalActive()) gameState.discardAutosave(); // Continue returns to the save slot
         btnHint->setEnabled(false);
+        btnFillNotes->setEnabled(false);
         btnSaveGame->setEnabled(false);
         btnSolve->setEnabled(false);
+        btnUndo->setEnabled(false);
+        btnRedo->setEnabled(false);
         statusLabel->setText("Puzzle Solved!");
     }
 }
@@ -491,60 +542,37 @@ void MainWindow::checkSolution() {
 // --- Cell Input Handling ---
 
 void MainWindow::handleCellInput(int row, int col) {
-    if (cells[row][col]->isReadOnly()) {
+    if (boardWidget->isReadOnly(row, col)) {
         return;
     }
 
     gameInProgress = true;
-    QString text = cells[row][col]->text();
-    cells[row][col]->setProperty("class", "");
-    uiHelper.applyCellStyle(cells[row][col], "default");
-
-    if (text.isEmpty()) {
-        return;
-    }
-
-    bool ok;
-    int userInput = text.toInt(&ok);
-
-    if (!ok || userInput < 1 || userInput > 9) {
-        uiHelper.applyCellStyle(cells[row][col], "incorrect");
-        statusLabel->setText("Invalid input (1-9).");
+    clearHint();
+    int userInput = boardWidget->value(row, col);
+    int previous = boardModel.value(row, col);
+    boardModel.setValue(row, col, userInput);
+    recordMove(moveSource, row, col, previous, userInput);
+    boardWidget->setCellStyle(row, col, entryStyle(row, col));
+
+    bool wasSolvable = solvability.isSolvable();
+    bool solvable = solvability.setValue(row, col, userInput);
+    if (userInput == 0) {
+        if (solvable && !wasSolvable) statusLabel->setText("The board can be completed again.");
         return;
     }
+    syncNotes(row, col);
 
-    bool conflict = false;
-    // Check row
-    for (int c = 0; c < SIZE; ++c) if (c != col && cells[row][c]->text() == text) conflict = true;
-    // Check column
-    if (!conflict) for (int r = 0; r < SIZE; ++r) if (r != row && cells[r][col]->text() == text) conflict = true;
-    // Check 3x3 block
-    if (!conflict) {
-        int startRow = (row / 3) * 3, startCol = (col / 3) * 3;
-        for (int r = startRow; r < startRow + 3 && !conflict; ++r) {
-            for (int c = startCol; c < startCol + 3; ++c) {
-                if ((r != row || c != col) && cells[r][c]->text() == text) {
-                    conflict = true;
-                    break;
-                }
-            }
-        }
-    }
-
-    if (conflict) {
-        uiHelper.applyCellStyle(cells[row][col], "incorrect");
+    if (boardModel.hasConflict(row, col)) {
         statusLabel->setText("Number conflicts with another cell.");
     }
     else if (!isCustomMode && solution[row][col] != 0) {
         if (userInput == solution[row][col]) {
-            uiHelper.applyCellStyle(cells[row][col], "correct");
             statusLabel->setText("Correct!");
             if (isBoardCompleteAndCorrect()) {
                 checkSolution();
             }
         }
         else {
-            uiHelper.applyCellStyle(cells[row][col], "incorrect");
             statusLabel->setText("Incorrect number for this cell.");
         }
     }
@@ -554,6 +582,43 @@ void MainWindow::handleCellInput(int row, int col) {
     else {
         statusLabel->setText("Number placed (no conflicts).");
     }
+
+    // A digit that fits here can still leave the board without a completion, say why
+    if (!solvable && !boardModel.hasConflict(row, col) && (isCustomMode || userInput == solution[row][col] || solution[row][col] == 0)) {
+        statusLabel->setText(isCustomMode ? "No solution fits these numbers any more."
+                                          : "The board can no longer be completed, an earlier entry is wrong.");
+    }
+}
+
+void MainWindow::handleNotesInput(int row, int col) {
+    unsigned int toggled = boardModel.notes(row, col) ^ boardWidget->notes(row, col);
+    boardModel.setNotes(row, col, boardWidget->notes(row, col));
+    if (isCustomMode) return; // no game to journal yet
+
+    gameInProgress = true;
+
+    // Journaled per digit, clearing a cell writes one record for each of its marks
+    for (int digit = 1; digit <= SIZE; ++digit) {
+        if (toggled & digitBit(digit)) recordMove(JournalEntryType::Note, row, col, 0, digit);
+    }
+}
+
+void MainWindow::fillNotes() {
+    if (isCustomMode) return;
+
+    boardModel.fillNotes();
+    boardWidget->beginBatch();
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            boardWidget->setNotes(row, col, boardModel.notes(row, col));
+        }
+    }
+    boardWidget->endBatch();
+    gameInProgress = true;
+
+    // Too many toggles to journal, a fresh autosave snapshot holds them all
+    gameState.autosaveGame(board, solution, boardModel.values(), boardModel.allNotes(), moveHistory, puzzleSeed);
+    statusLabel->setText("Notes filled with every candidate.");
 }
 
 // --- Helper Methods ---
@@ -569,15 +634,143 @@ void MainWindow::clearBoardForCustom() {
 
 bool MainWindow::isBoardCompleteAndCorrect() {
     if (isCustomMode) return false;
+    return boardModel.isSolved();
+}
+
+void MainWindow::loadBoardModel() {
+    boardModel.load(board, solution);
+    solvability.load(board, solution);
+    shownHint = Hint(); // the board widget drops its highlights in updateBoardUI
+}
+
+void MainWindow::clearHint() {
+    if (shownHint.kind == Hint::Kind::None) return;
+    shownHint = Hint();
+    boardWidget->beginBatch();
+    boardWidget->clearHighlights();
+    boardWidget->endBatch();
+}
+
+QString MainWindow::describeHint(const Hint& hint) const {
+    int row = hint.cell / SIZE + 1, col = hint.cell % SIZE + 1;
+    switch (hint.kind) {
+    case Hint::Kind::WrongEntry:
+        return QString("Cell (%1, %2) holds a wrong digit.").arg(row).arg(col);
+    case Hint::Kind::Reveal:
+        return QString("No logical step left, cell (%1, %2) is %3.").arg(row).arg(col).arg(hint.digit);
+    case Hint::Kind::Deduction:
+        break;
+    case Hint::Kind::None:
+        return QString();
+    }
+
+    QString text;
+    if (hint.step.technique == Technique::HiddenSingle) {
+        static const char* UNIT_KINDS[] = { "row", "column", "box" };
+        int unit = hint.step.unit;
+        text = QString("Hidden Single: %1 fits only one cell of %2 %3.")
+            .arg(hint.digit).arg(UNIT_KINDS[unit / SIZE]).arg(unit % SIZE + 1);
+    }
+    else {
+        text = QString("Naked Single: only %1 fits cell (%2, %3).").arg(hint.digit).arg(row).arg(col);
+    }
+    if (hint.step.preparedBy != Technique::None) {
+        text += QString(" It shows once %1 removes candidates.").arg(PuzzleGrader::techniqueName(hint.step.preparedBy));
+    }
+    return text;
+}
+
+// Placing a digit prunes the notes of the cell and its peers in the model, show the same on the board
+void MainWindow::syncNotes(int row, int col) {
+    int cell = row * SIZE + col;
+    boardWidget->beginBatch();
+    boardWidget->setNotes(row, col, boardModel.notes(row, col));
+    for (int peer : CLASSIC_TABLES.peers[cell]) {
+        boardWidget->setNotes(peer / SIZE, peer % SIZE, boardModel.notes(peer / SIZE, peer % SIZE));
+    }
+    boardWidget->endBatch();
+}
+
+// Style of a player entry: conflicts and, once the solution is known, wrong digits are marked
+CellStyle MainWindow::entryStyle(int row, int col) const {
+    int value = boardModel.value(row, col);
+    if (value == 0) return CellStyle::Default;
+    if (boardModel.hasConflict(row, col)) return CellStyle::Incorrect;
+    if (isCustomMode || solution[row][col] == 0) return CellStyle::Default;
+    return value == solution[row][col] ? CellStyle::Correct : CellStyle::Incorrect;
+}
+
+void MainWindow::recordMove(JournalEntryType type, int row, int col, int oldValue, int value) {
+    if (isCustomMode) return;
 
-    QVector<QVector<QString>> cellTexts(SIZE, QVector<QString>(SIZE));
-    for (int r = 0; r < SIZE; ++r) {
-        for (int c = 0; c < SIZE; ++c) {
-            cellTexts[r][c] = cells[r][c]->text();
+    if (type == JournalEntryType::Reset) {
+        moveHistory.clear();
+    }
+    else {
+        if (oldValue == value) return;
+        if (type == JournalEntryType::CellEdit || type == JournalEntryType::Hint) {
+            MoveRecord move;
+            move.cell = static_cast<uint8_t>(row * SIZE + col);
+            move.oldValue = static_cast<uint8_t>(oldValue);
+            move.newValue = static_cast<uint8_t>(value);
+            move.source = static_cast<uint8_t>(type);
+            moveHistory.push(move);
         }
     }
+    updateUndoButtons();
+
+    // First move of this session: the autosave snapshot already contains it
+    if (!gameState.journalActive()) {
+        gameState.autosaveGame(board, solution, boardModel.values(), boardModel.allNotes(), moveHistory, puzzleSeed);
+        return;
+    }
+    gameState.appendMove(type, row, col, value);
+}
+
+void MainWindow::applyHistoryMove(JournalEntryType type, int cell, int value) {
+    int row = cell / SIZE, col = cell % SIZE;
+
+    // Goes through handleCellInput like a typed digit, so styling and the journal stay in step
+    moveSource = type;
+    boardWidget->setValue(row, col, value);
+    moveSource = JournalEntryType::CellEdit;
+    boardWidget->selectCell(row, col);
+    boardWidget->setFocus();
+}
+
+void MainWindow::updateUndoButtons() {
+    btnUndo->setEnabled(!isCustomMode && moveHistory.canUndo());
+    btnRedo->setEnabled(!isCustomMode && moveHistory.canRedo());
+}
+
+// --- Solver Statistics Overlay ---
+
+void MainWindow::toggleStatsOverlay() {
+    if (!statsOverlay) return;
+    statsOverlay->setVisible(!statsOverlay->isVisible());
+    statsOverlay->raise();
+}
 
-    return sudokuLogic.isBoardCompleteAndCorrect(board, solution, cellTexts);
+void MainWindow::showSolverStats(const SolverStats& stats, const QString& source) {
+    if (!statsOverlay) return;
+    statsOverlay->setText(QString("Solver stats (%1)\n"
+        "attempts:       %2\n"
+        "nodes:          %3\n"
+        "backtracks:     %4\n"
+        "max depth:      %5\n"
+        "unique checks:  %6\n"
+        "fill / dig / grade: %7 / %8 / %9 ms")
+        .arg(source)
+        .arg(stats.attempts)
+        .arg(stats.nodes)
+        .arg(stats.backtracks)
+        .arg(stats.maxDepth)
+        .arg(stats.uniquenessChecks)
+        .arg(stats.fillMs, 0, 'f', 2)
+        .arg(stats.digMs, 0, 'f', 2)
+        .arg(stats.gradeMs, 0, 'f', 2));
+    statsOverlay->adjustSize();
+    statsOverlay->raise();
 }
 
 // --- Window Event Handling ---
@@ -600,6 +793,7 @@ void MainWindow::closeEvent(QCloseEvent* event) {
             event->accept();
         }
         else if (reply == QMessageBox::Discard) {
+            if (gameState.journalActive()) gameState.discardAutosave();
             event->accept();
         }
         else { // Cancel
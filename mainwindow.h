@@ -4,23 +4,26 @@
 #include <QMainWindow>
 #include <QPainter>
 #include <QVBoxLayout>
-#include <QGridLayout>
-#include <QLineEdit>
 #include <QPushButton>
 #include <QLabel>
 #include <QMessageBox>
 #include <QGroupBox>
-#include <QIntValidator>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QDir>
 #include <QCloseEvent>
+#include <QShortcut>
 
 #include "sudokulogic.h"
 #include "gamestate.h"
 #include "uihelper.h"
+#include "puzzlequeue.h"
+#include "boardmodel.h"
+#include "boardwidget.h"
+#include "hintengine.h"
+#include "solvabilitytracker.h"
 
 class MainMenu;
 
@@ -30,8 +33,9 @@ class MainWindow : public QMainWindow {
 public:
     enum class Mode { NewGame, Custom, Continue };
 
-    explicit MainWindow(int modeValue, QWidget* parent = nullptr); // modeValue: 0=Custom, 1=Easy, 2=Medium, 3=Hard
-    explicit MainWindow(Mode mode, QWidget* parent = nullptr); // Constructor for Continue mode
+    // puzzleQueue may be null, new games are then generated on the GUI thread
+    explicit MainWindow(int modeValue, PuzzleQueue* puzzleQueue, QWidget* parent = nullptr); // modeValue: 0=Custom, 1=Easy, 2=Medium, 3=Hard, 4=Expert
+    explicit MainWindow(Mode mode, PuzzleQueue* puzzleQueue, QWidget* parent = nullptr); // Constructor for Continue mode
     ~MainWindow();
 
 protected:
@@ -45,19 +49,28 @@ private slots:
     void giveHint();
     void showSolution();
     void resetBoard();
+    void undoMove();
+    void redoMove();
     void validateCustomBoard();
     void saveGame();
     void handleCellInput(int row, int col);
+    void handleNotesInput(int row, int col);
+    void fillNotes();
     void backToMenu();
+    void onPuzzleAvailable(int difficulty);
+    void toggleStatsOverlay();
 
 private:
     int board[SIZE][SIZE] = { 0 };
     int solution[SIZE][SIZE] = { 0 };
-    QLineEdit* cells[SIZE][SIZE];
+    BoardModel boardModel; // givens plus player entries, kept in sync with the board widget
+    SolvabilityTracker solvability; // whether boardModel can still be completed
+    BoardWidget* boardWidget;
     QPushButton* btnHint, * btnSolve, * btnReset, * btnBackMenu, * btnValidateCustom;
-    QPushButton* btnSaveGame;
+    QPushButton* btnSaveGame, * btnUndo, * btnRedo;
+    QPushButton* btnNotes, * btnFillNotes;
     QLabel* statusLabel;
-    QGridLayout* gridLayout;
+    QLabel* statsOverlay = nullptr; // solver statistics, F12 in builds with SUDOKU_SOLVER_STATS
     QWidget* centralWidget;
 
     bool isCustomMode = false;
@@ -71,9 +84,19 @@ private:
     SudokuLogic sudokuLogic;
     GameState gameState;
     UIHelper uiHelper;
+    HintEngine hintEngine;
+    Hint shownHint; // pointed at on the board, Hint again carries it out
+    PuzzleQueue* puzzleQueue = nullptr;
+    int pendingDifficulty = 0; // difficulty waited for while the queue refills, 0 = none
+    uint64_t puzzleSeed = 0;   // seed the current puzzle was generated from, 0 = custom
+
+    // Autosave journal
+    JournalEntryType moveSource = JournalEntryType::CellEdit;
+    MoveHistory moveHistory;
 
     void setupUI();
     void generateNewGameInternal(int difficulty);
+    void startGeneratedGame(const GeneratedPuzzle& puzzle);
     void startCustomGameInternal();
     void continueGameInternal();
 
@@ -82,6 +105,15 @@ private:
 
     // Helper functions
     bool isBoardCompleteAndCorrect();
+    void loadBoardModel();
+    CellStyle entryStyle(int row, int col) const;
+    void syncNotes(int row, int col);
+    void clearHint();
+    QString describeHint(const Hint& hint) const;
+    void recordMove(JournalEntryType type, int row, int col, int oldValue, int value);
+    void applyHistoryMove(JournalEntryType type, int cell, int value);
+    void updateUndoButtons();
+    void showSolverStats(const SolverStats& stats, const QString& source);
     QString getSaveFilePath();
     bool hasSavedGame();
 };
@@ -0,0 +1,132 @@
+#include "minimaldigger.h"
+
+#include <algorithm>
+
+MinimalDigger::MinimalDigger(Xoshiro256& rng) : rng(rng) {
+}
+
+int MinimalDigger::dig(int board[N][N], const int solutionGrid[N][N]) {
+    solver.setStats(stats);
+    solver.load(board);
+    for (int cell = 0; cell < CELLS; ++cell) {
+        solution[cell] = static_cast<uint8_t>(solutionGrid[cell / N][cell % N]);
+        isGiven[cell] = diggable[cell] = board[cell / N][cell % N] != 0;
+    }
+    witnesses.clear();
+    nextWitness = 0;
+
+    reduce();
+    int best = givenCount();
+    bool bestGivens[CELLS];
+    std::copy(isGiven, isGiven + CELLS, bestGivens);
+
+    std::vector<int> removed;
+    for (int round = 0; round < EXPAND_ROUNDS && best > TARGET_GIVENS; ++round) {
+        removed.clear();
+        for (int cell = 0; cell < CELLS; ++cell) {
+            if (diggable[cell] && !isGiven[cell]) removed.push_back(cell);
+        }
+        rng.shuffle(removed.begin(), removed.end());
+        for (int i = 0; i < EXPAND_GIVENS && i < static_cast<int>(removed.size()); ++i) {
+            int partner = symmetricCell(symmetry, removed[i]);
+            if (!isGiven[removed[i]]) setGiven(removed[i], true);
+            if (diggable[partner] && !isGiven[partner]) setGiven(partner, true);
+        }
+
+        reduce();
+        int count = givenCount();
+        if (count <= best) {
+            // Equal counts are taken too, so the rounds can drift across plateaus
+            best = count;
+            std::copy(isGiven, isGiven + CELLS, bestGivens);
+        }
+        else {
+            for (int cell = 0; cell < CELLS; ++cell) {
+                if (isGiven[cell] != bestGivens[cell]) setGiven(cell, bestGivens[cell]);
+            }
+        }
+    }
+
+    for (int cell = 0; cell < CELLS; ++cell) {
+        board[cell / N][cell % N] = isGiven[cell] ? solution[cell] : 0;
+    }
+    return best;
+}
+
+// One pass over the givens in random order. A group that cannot go now cannot go
+// later either, fewer givens never make a puzzle unique again, so the result is minimal.
+void MinimalDigger::reduce() {
+    int order[CELLS];
+    for (int cell = 0; cell < CELLS; ++cell) order[cell] = cell;
+    rng.shuffle(order, order + CELLS);
+
+    int group[2];
+    for (int cell : order) {
+        if (!isGiven[cell]) continue;
+        int count = groupOf(cell, group);
+        if (removable(group, count)) {
+            for (int i = 0; i < count; ++i) setGiven(group[i], false);
+        }
+    }
+}
+
+int MinimalDigger::groupOf(int cell, int group[2]) const {
+    group[0] = cell;
+    int partner = symmetricCell(symmetry, cell);
+    if (partner == cell || !isGiven[partner]) return 1;
+    group[1] = partner;
+    return 2;
+}
+
+bool MinimalDigger::removable(const int group[], int count) {
+    for (const Witness& witness : witnesses) {
+        int inGroup = 0;
+        for (int i = 0; i < count; ++i) inGroup += witness.cells[group[i]] != solution[group[i]];
+        if (inGroup > 0 && witness.mismatches == inGroup) return false;
+    }
+
+    SOLVER_STAT(if (stats) stats->uniquenessChecks++);
+    int values[2] = { 0, 0 };
+    for (int i = 0; i < count; ++i) {
+        values[i] = solution[group[i]];
+        solver.unplace(group[i] / N, group[i] % N);
+    }
+    int alternative[N][N];
+    bool ambiguous = solver.hasAlternative(group, values, count, alternative);
+    for (int i = 0; i < count; ++i) solver.place(group[i] / N, group[i] % N, values[i]);
+
+    if (ambiguous) addWitness(alternative);
+    return !ambiguous;
+}
+
+void MinimalDigger::setGiven(int cell, bool given) {
+    int value = solution[cell];
+    if (given) solver.place(cell / N, cell % N, value);
+    else solver.unplace(cell / N, cell % N);
+    isGiven[cell] = given;
+
+    for (Witness& witness : witnesses) {
+        if (witness.cells[cell] != value) witness.mismatches += given ? 1 : -1;
+    }
+}
+
+void MinimalDigger::addWitness(const int alternative[N][N]) {
+    Witness witness;
+    witness.mismatches = 0;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        witness.cells[cell] = static_cast<uint8_t>(alternative[cell / N][cell % N]);
+        if (isGiven[cell] && witness.cells[cell] != solution[cell]) witness.mismatches++;
+    }
+
+    if (witnesses.size() < static_cast<size_t>(MAX_WITNESSES)) {
+        witnesses.push_back(witness);
+    }
+    else {
+        witnesses[nextWitness] = witness;
+        nextWitness = (nextWitness + 1) % MAX_WITNESSES;
+    }
+}
+
+int MinimalDigger::givenCount() const {
+    return static_cast<int>(std::count(isGiven, isGiven + CELLS, true));
+}
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef MINIMALDIGGER_H
+#define MINIMALDIGGER_H
+
+#include <cstdint>
+#include <vector>
+
+#include "candidatesolver.h"
+#include "solverstats.h"
+#include "symmetry.h"
+#include "xoshiro.h"
+
+// Digs a solution grid down to a minimal puzzle: one where no given can be
+// removed without losing uniqueness. A single pass over the cells lands on
+// 23-26 givens; the expand and reduce rounds then put a few removed givens back
+// and dig again, keeping the result whenever it has no more givens, which walks
+// down to 20-22.
+//
+// Every trial reuses the search state of the last. The givens live in one
+// CandidateSolver that is only placed into and unplaced from, and every
+// alternative solution found is kept as a witness. A witness that differs from
+// the current givens only at the cells being tried proves that removal ambiguous
+// without searching, and it stays valid as long as those givens are not put back.
+//
+// With a symmetry set, a given and its partner are removed and put back together,
+// and the result is minimal among symmetric puzzles.
+class MinimalDigger {
+public:
+    static const int N = CandidateSolver::N;
+    static const int CELLS = CandidateSolver::CELLS;
+
+    static const int EXPAND_ROUNDS = 100;  // expand and reduce rounds after the first pass
+    static const int EXPAND_GIVENS = 3;    // removed givens (with their partners) put back per round
+    static const int TARGET_GIVENS = 20;   // stop the rounds once a puzzle this small is found
+    static const int MAX_WITNESSES = 1024; // oldest witnesses are overwritten after that
+
+    explicit MinimalDigger(Xoshiro256& rng);
+
+    // Digs board, a puzzle with exactly one solution, to a minimal puzzle. Cells that
+    // are empty on entry stay empty. Returns the givens left.
+    int dig(int board[N][N], const int solution[N][N]);
+
+    void setSymmetry(Symmetry value) { symmetry = value; }
+    // Search counters and uniqueness checks are added to stats, null = off
+    void setStats(SolverStats* target) { stats = target; }
+
+private:
+    struct Witness {
+        uint8_t cells[CELLS];
+        int mismatches; // givens this solution disagrees with
+    };
+
+    void reduce();
+    int groupOf(int cell, int group[2]) const; // givens removed together with cell
+    bool removable(const int group[], int count);
+    void setGiven(int cell, bool given);
+    void addWitness(const int alternative[N][N]);
+    int givenCount() const;
+
+    Xoshiro256& rng;
+    Symmetry symmetry = Symmetry::None;
+    SolverStats* stats = nullptr;
+    CandidateSolver solver;
+    uint8_t solution[CELLS];
+    bool isGiven[CELLS];
+    bool diggable[CELLS]; // given on entry, may be removed and put back
+    std::vector<Witness> witnesses;
+    size_t nextWitness = 0; // slot overwritten next once the store is full
+};
+
+#endif // MINIMALDIGGER_H
@@ -0,0 +1,41 @@
+#include "movehistory.h"
+
+void MoveHistory::push(const MoveRecord& move) {
+    count = cursor;
+    if (count == CAPACITY) {
+        first = (first + 1) % CAPACITY;
+        count--;
+    }
+    moves[(first + count) % CAPACITY] = move;
+    count++;
+    cursor = count;
+}
+
+bool MoveHistory::undo(MoveRecord& move) {
+    if (!canUndo()) return false;
+    cursor--;
+    move = at(cursor);
+    return true;
+}
+
+bool MoveHistory::redo(MoveRecord& move) {
+    if (!canRedo()) return false;
+    move = at(cursor);
+    cursor++;
+    return true;
+}
+
+void MoveHistory::clear() {
+    first = 0;
+    count = 0;
+    cursor = 0;
+}
+
+bool MoveHistory::restore(const MoveRecord* records, int recordCount, int appliedCount) {
+    if (recordCount < 0 || recordCount > CAPACITY || appliedCount < 0 || appliedCount > recordCount) return false;
+    first = 0;
+    for (int i = 0; i < recordCount; ++i) moves[i] = records[i];
+    count = recordCount;
+    cursor = appliedCount;
+    return true;
+}
@@ -0,0 +1,48 @@
+#pragma once
+#ifndef MOVEHISTORY_H
+#define MOVEHISTORY_H
+
+#include <cstdint>
+
+// One player move. source is the JournalEntryType that produced it (edit or hint).
+struct MoveRecord {
+    uint8_t cell = 0;      // row * 9 + col
+    uint8_t oldValue = 0;  // 0 = empty
+    uint8_t newValue = 0;
+    uint8_t source = 0;
+};
+
+// Bounded undo/redo history. Moves live in a fixed ring buffer, so pushing,
+// undoing and redoing are O(1) and never allocate. Once full, the oldest move
+// is dropped.
+class MoveHistory {
+public:
+    static const int CAPACITY = 256;
+
+    // Records a new move and discards everything that could have been redone
+    void push(const MoveRecord& move);
+
+    // Steps back or forward. move receives the record to revert or re-apply.
+    bool undo(MoveRecord& move);
+    bool redo(MoveRecord& move);
+
+    bool canUndo() const { return cursor > 0; }
+    bool canRedo() const { return cursor < count; }
+    void clear();
+
+    // Moves in order, oldest first. position() of them are currently applied.
+    int size() const { return count; }
+    int position() const { return cursor; }
+    const MoveRecord& at(int index) const { return moves[(first + index) % CAPACITY]; }
+
+    // Replaces the history, used when loading a save. Returns false if out of range.
+    bool restore(const MoveRecord* records, int recordCount, int appliedCount);
+
+private:
+    MoveRecord moves[CAPACITY];
+    int first = 0;   // ring index of the oldest move
+    int count = 0;   // moves stored
+    int cursor = 0;  // moves applied, the rest can be redone
+};
+
+#endif // MOVEHISTORY_H
@@ -0,0 +1,221 @@
+#include "puzzlebank.h"
+
+#include <QDebug>
+#include <QDir>
+#include <QSaveFile>
+#include <QStandardPaths>
+
+#include <algorithm>
+#include <random>
+
+namespace {
+
+const uint8_t BANK_MAGIC[4] = { 'S', 'D', 'K', 'B' };
+const int RANDOM_PROBES = 16;
+
+uint32_t fnv1a(const uint8_t* data, int size) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void writeLittleEndian(uint8_t* out, uint64_t value, int bytes) {
+    for (int i = 0; i < bytes; ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint64_t readLittleEndian(const uint8_t* data, int bytes) {
+    uint64_t value = 0;
+    for (int i = 0; i < bytes; ++i) value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    return value;
+}
+
+bool testBit(const QByteArray& bits, uint32_t index) {
+    return (static_cast<uint8_t>(bits[static_cast<int>(index / 8)]) >> (index % 8)) & 1;
+}
+
+void assignBit(QByteArray& bits, uint32_t index, bool value) {
+    char& byte = bits[static_cast<int>(index / 8)];
+    if (value) byte = static_cast<char>(byte | (1 << (index % 8)));
+    else byte = static_cast<char>(byte & ~(1 << (index % 8)));
+}
+
+} // namespace
+
+// --- File format ---
+
+void encodeBankHeader(const BankSection sections[BANK_SECTIONS], uint8_t out[BANK_HEADER_BYTES]) {
+    for (int i = 0; i < BANK_HEADER_BYTES; ++i) out[i] = 0;
+    for (int i = 0; i < 4; ++i) out[i] = BANK_MAGIC[i];
+    out[4] = BANK_FORMAT_VERSION;
+
+    for (int s = 0; s < BANK_SECTIONS; ++s) {
+        uint8_t* entry = out + 8 + s * 16;
+        writeLittleEndian(entry, sections[s].baseSeed, 8);
+        writeLittleEndian(entry + 8, sections[s].first, 4);
+        writeLittleEndian(entry + 12, sections[s].count, 4);
+    }
+}
+
+bool decodeBankHeader(const uint8_t* data, int64_t size, BankSection sections[BANK_SECTIONS]) {
+    if (size < BANK_HEADER_BYTES) return false;
+    for (int i = 0; i < 4; ++i) {
+        if (data[i] != BANK_MAGIC[i]) return false;
+    }
+    if (data[4] != BANK_FORMAT_VERSION) return false;
+
+    const int64_t records = (size - BANK_HEADER_BYTES) / BANK_RECORD_BYTES;
+    for (int s = 0; s < BANK_SECTIONS; ++s) {
+        const uint8_t* entry = data + 8 + s * 16;
+        sections[s].baseSeed = readLittleEndian(entry, 8);
+        sections[s].first = static_cast<uint32_t>(readLittleEndian(entry + 8, 4));
+        sections[s].count = static_cast<uint32_t>(readLittleEndian(entry + 12, 4));
+        if (static_cast<int64_t>(sections[s].first) + sections[s].count > records) return false;
+    }
+    return true;
+}
+
+void encodeBankRecord(const int board[9][9], const int solution[9][9], uint8_t out[BANK_RECORD_BYTES]) {
+    packBoard(solution, out);
+    packGivenMask(board, out + PACKED_BOARD_BYTES);
+}
+
+bool decodeBankRecord(const uint8_t record[BANK_RECORD_BYTES], int board[9][9], int solution[9][9]) {
+    if (!unpackBoard(record, solution)) return false;
+    const uint8_t* givens = record + PACKED_BOARD_BYTES;
+    for (int i = 0; i < 81; ++i) {
+        int value = solution[i / 9][i % 9];
+        if (value == 0) return false; // a bank record always holds a complete solution
+        board[i / 9][i % 9] = isGivenCell(givens, i) ? value : 0;
+    }
+    return true;
+}
+
+// --- PuzzleBank ---
+
+PuzzleBank::PuzzleBank() {
+    std::random_device device;
+    rng.seed((static_cast<uint64_t>(device()) << 32) | device());
+}
+
+PuzzleBank::~PuzzleBank() {
+    if (data) file.unmap(const_cast<uint8_t*>(data));
+}
+
+QString PuzzleBank::getPlayedFilePath() {
+    QString appDataPath = QStandardPaths::writableLocation(QStandardPaths::AppDataLocation);
+    QDir dir(appDataPath);
+    if (!dir.exists()) {
+        dir.mkpath(".");
+    }
+    return appDataPath + "/played_puzzles.bin";
+}
+
+bool PuzzleBank::open(const QString& path) {
+    file.setFileName(path);
+    if (!file.exists()) return false;
+    if (!file.open(QIODevice::ReadOnly)) {
+        qDebug() << "Could not open puzzle bank" << path << ":" << file.errorString();
+        return false;
+    }
+
+    qint64 size = file.size();
+    const uint8_t* mapped = file.map(0, size);
+    if (!mapped || !decodeBankHeader(mapped, size, sections)) {
+        qDebug() << "Invalid puzzle bank" << path;
+        if (mapped) file.unmap(const_cast<uint8_t*>(mapped));
+        file.close();
+        return false;
+    }
+
+    data = mapped;
+    bankId = fnv1a(data, BANK_HEADER_BYTES);
+    loadPlayedSet();
+    qDebug() << "Puzzle bank loaded:" << count(1) << "easy," << count(2) << "medium," << count(3) << "hard";
+    return true;
+}
+
+int PuzzleBank::count(int difficulty) const {
+    if (!isOpen() || difficulty < 1 || difficulty > BANK_SECTIONS) return 0;
+    return static_cast<int>(sections[difficulty - 1].count - corruptCount[difficulty - 1]);
+}
+
+bool PuzzleBank::takePuzzle(int difficulty, uint64_t& seed, int board[9][9], int solution[9][9]) {
+    while (count(difficulty) > 0) {
+        const BankSection& section = sections[difficulty - 1];
+        const uint32_t index = pickRecord(section);
+        if (decodeBankRecord(data + BANK_HEADER_BYTES + static_cast<qint64>(index) * BANK_RECORD_BYTES, board, solution)) {
+            seed = section.baseSeed + (index - section.first);
+            setPlayed(index, true);
+            savePlayedSet();
+            return true;
+        }
+        qDebug() << "Corrupt puzzle bank record" << index << "skipped";
+        assignBit(corruptBits, index, true);
+        corruptCount[difficulty - 1]++;
+    }
+    return false;
+}
+
+// An unplayed intact record, at random. Once all intact records of the section have
+// been played they count as unplayed again. Only called while count() > 0.
+uint32_t PuzzleBank::pickRecord(const BankSection& section) {
+    // Random probes almost always hit an unplayed record; if not, scan on from the last probe
+    uint32_t offset = rng.below(section.count);
+    for (int probe = 1; probe < RANDOM_PROBES && !isAvailable(section.first + offset); ++probe) {
+        offset = rng.below(section.count);
+    }
+    for (int pass = 0; pass < 2; ++pass) {
+        for (uint32_t step = 0; step < section.count; ++step) {
+            uint32_t index = section.first + (offset + step) % section.count;
+            if (isAvailable(index)) return index;
+        }
+        // Every puzzle of this difficulty was played, start over
+        for (uint32_t i = 0; i < section.count; ++i) setPlayed(section.first + i, false);
+    }
+    return section.first + offset;
+}
+
+// --- Played set ---
+
+bool PuzzleBank::isPlayed(uint32_t index) const {
+    return testBit(playedBits, index);
+}
+
+void PuzzleBank::setPlayed(uint32_t index, bool played) {
+    assignBit(playedBits, index, played);
+}
+
+bool PuzzleBank::isAvailable(uint32_t index) const {
+    return !isPlayed(index) && !testBit(corruptBits, index);
+}
+
+void PuzzleBank::loadPlayedSet() {
+    uint32_t records = 0;
+    for (const BankSection& section : sections) records = std::max(records, section.first + section.count);
+    playedBits.fill(0, static_cast<int>((records + 7) / 8));
+    corruptBits.fill(0, playedBits.size());
+
+    // File layout: bank id (4 bytes) followed by the bitmap. A different bank starts a fresh set.
+    QFile playedFile(getPlayedFilePath());
+    if (!playedFile.open(QIODevice::ReadOnly)) return;
+    QByteArray stored = playedFile.readAll();
+    if (stored.size() != 4 + playedBits.size()) return;
+    if (readLittleEndian(reinterpret_cast<const uint8_t*>(stored.constData()), 4) != bankId) return;
+    playedBits = stored.mid(4);
+}
+
+void PuzzleBank::savePlayedSet() {
+    uint8_t id[4];
+    writeLittleEndian(id, bankId, 4);
+
+    QSaveFile playedFile(getPlayedFilePath());
+    if (!playedFile.open(QIODevice::WriteOnly)
+        || playedFile.write(reinterpret_cast<const char*>(id), 4) != 4
+        || playedFile.write(playedBits) != playedBits.size()
+        || !playedFile.commit()) {
+        qDebug() << "Could not save the played puzzle set:" << playedFile.errorString();
+    }
+}
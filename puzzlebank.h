@@ -0,0 +1,76 @@
+#pragma once
+#ifndef PUZZLEBANK_H
+#define PUZZLEBANK_H
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+#include <cstdint>
+
+#include "boardpacking.h"
+#include "xoshiro.h"
+
+// Puzzle bank file, version 1:
+//   0   magic "SDKB"
+//   4   format version
+//   5   reserved (3 bytes, 0)
+//   8   one 16-byte section per difficulty (Easy, Medium, Hard):
+//         base seed (8), first record (4), record count (4), little-endian
+//   56  records grouped by section, BANK_RECORD_BYTES each:
+//         solution, nibble-packed (41 bytes), given-cell bitmask (11 bytes)
+// Record i of a section is SudokuLogic::generatePuzzle(base seed + i, difficulty).
+const int BANK_FORMAT_VERSION = 1;
+const int BANK_SECTIONS = 3;
+const int BANK_HEADER_BYTES = 8 + BANK_SECTIONS * 16;
+const int BANK_RECORD_BYTES = PACKED_BOARD_BYTES + GIVEN_MASK_BYTES;
+
+struct BankSection {
+    uint64_t baseSeed = 0;
+    uint32_t first = 0;
+    uint32_t count = 0;
+};
+
+void encodeBankHeader(const BankSection sections[BANK_SECTIONS], uint8_t out[BANK_HEADER_BYTES]);
+// Validates magic, version and that every section fits in size bytes
+bool decodeBankHeader(const uint8_t* data, int64_t size, BankSection sections[BANK_SECTIONS]);
+void encodeBankRecord(const int board[9][9], const int solution[9][9], uint8_t out[BANK_RECORD_BYTES]);
+bool decodeBankRecord(const uint8_t record[BANK_RECORD_BYTES], int board[9][9], int solution[9][9]);
+
+// Read-only view of a bank file mapped into memory. Picking a puzzle is a
+// random index into the section plus one record decode, nothing is solved.
+// Puzzles already handed out are kept in a bitmap in the user's app data
+// directory so they are not repeated until a whole section has been played.
+class PuzzleBank {
+public:
+    PuzzleBank();
+    ~PuzzleBank();
+
+    bool open(const QString& path);
+    bool isOpen() const { return data != nullptr; }
+    int count(int difficulty) const; // records that decoded or were not tried yet
+
+    // Picks an unplayed puzzle of the difficulty (1-3) and marks it played. Records that
+    // fail to decode are skipped for the rest of the session and another one is drawn.
+    bool takePuzzle(int difficulty, uint64_t& seed, int board[9][9], int solution[9][9]);
+
+    QString getPlayedFilePath();
+
+private:
+    bool isPlayed(uint32_t index) const;
+    void setPlayed(uint32_t index, bool played);
+    bool isAvailable(uint32_t index) const;
+    uint32_t pickRecord(const BankSection& section);
+    void loadPlayedSet();
+    void savePlayedSet();
+
+    QFile file;
+    const uint8_t* data = nullptr;
+    BankSection sections[BANK_SECTIONS];
+    uint32_t bankId = 0;       // checksum of the header, ties the played set to this bank
+    QByteArray playedBits;     // one bit per record
+    QByteArray corruptBits;    // one bit per record, found corrupt this session
+    uint32_t corruptCount[BANK_SECTIONS] = {};
+    Xoshiro256 rng;
+};
+
+#endif // PUZZLEBANK_H
@@ -0,0 +1,370 @@
+#include "puzzlegrader.h"
+#include "boardtables.h"
+
+#include <algorithm>
+
+namespace {
+
+const int UNITS = ClassicBoard::UNITS; // rows 0-8, columns 9-17, boxes 18-26
+
+const BoardTables<3>& tables = CLASSIC_TABLES;
+
+// Calls visit for every k-subset of 0..n-1 (k <= 4) until it returns true
+template <typename Visit>
+bool forEachCombination(int n, int k, Visit visit) {
+    if (k > n) return false;
+    int index[4];
+    for (int i = 0; i < k; ++i) index[i] = i;
+    while (true) {
+        if (visit(index)) return true;
+        int i = k - 1;
+        while (i >= 0 && index[i] == n - k + i) --i;
+        if (i < 0) return false;
+        index[i]++;
+        for (int j = i + 1; j < k; ++j) index[j] = index[j - 1] + 1;
+    }
+}
+
+} // namespace
+
+PuzzleGrade PuzzleGrader::grade(const int board[N][N]) {
+    PuzzleGrade result;
+    if (!load(board)) return result; // conflicting givens
+
+    while (unsolved > 0 && !contradiction) {
+        Technique used;
+        if (hiddenSingles()) used = Technique::HiddenSingle;
+        else if (nakedSingles()) used = Technique::NakedSingle;
+        else if (!applyElimination(used)) break;
+
+        result.hardest = std::max(result.hardest, used);
+        result.steps++;
+    }
+
+    result.solved = unsolved == 0 && !contradiction;
+    if (!result.solved) result.hardest = Technique::Guessing;
+    return result;
+}
+
+PuzzleStep PuzzleGrader::nextStep(const int board[N][N]) {
+    PuzzleStep step;
+    if (!load(board) || unsolved == 0) return step;
+
+    while (!contradiction) {
+        if (findSingle(step)) return step;
+        Technique used;
+        if (!applyElimination(used)) break;
+        step.preparedBy = std::max(step.preparedBy, used);
+    }
+    if (contradiction) return step;
+
+    // Logic is stuck, point at the cell that is cheapest to guess
+    step.technique = Technique::Guessing;
+    step.preparedBy = Technique::None;
+    int fewest = N + 1;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        int options = popCount(candidates[cell]);
+        if (values[cell] == 0 && options < fewest) {
+            fewest = options;
+            step.cell = cell;
+        }
+    }
+    return step;
+}
+
+const char* PuzzleGrader::techniqueName(Technique technique) {
+    switch (technique) {
+    case Technique::None: return "None";
+    case Technique::HiddenSingle: return "Hidden Single";
+    case Technique::NakedSingle: return "Naked Single";
+    case Technique::LockedCandidates: return "Locked Candidates";
+    case Technique::NakedPair: return "Naked Pair";
+    case Technique::HiddenPair: return "Hidden Pair";
+    case Technique::NakedTriple: return "Naked Triple";
+    case Technique::XWing: return "X-Wing";
+    case Technique::Swordfish: return "Swordfish";
+    case Technique::Guessing: return "Guessing";
+    }
+    return "Unknown";
+}
+
+// --- Board updates ---
+
+bool PuzzleGrader::load(const int board[N][N]) {
+    std::fill(values, values + CELLS, 0);
+    std::fill(candidates, candidates + CELLS, static_cast<uint16_t>(ALL_DIGITS));
+    unsolved = CELLS;
+    contradiction = false;
+
+    for (int cell = 0; cell < CELLS; ++cell) {
+        int num = board[cell / N][cell % N];
+        if (num == 0) continue;
+        if (num < 1 || num > N || !(candidates[cell] & digitBit(num))) return false;
+        place(cell, num);
+    }
+    return true;
+}
+
+void PuzzleGrader::place(int cell, int num) {
+    unsigned int bit = digitBit(num);
+    values[cell] = static_cast<uint8_t>(num);
+    candidates[cell] = 0;
+    unsolved--;
+    for (uint8_t peer : tables.peers[cell]) {
+        if (values[peer] == 0 && (candidates[peer] & bit)) {
+            candidates[peer] &= ~bit;
+            if (candidates[peer] == 0) contradiction = true;
+        }
+    }
+}
+
+bool PuzzleGrader::eliminate(int cell, unsigned int mask) {
+    if (values[cell] != 0 || !(candidates[cell] & mask)) return false;
+    candidates[cell] &= ~mask;
+    if (candidates[cell] == 0) contradiction = true;
+    return true;
+}
+
+// --- Techniques, each returns true if it changed the board ---
+
+// Finds one single without placing it: hidden singles in boxes, rows and
+// columns first, since people spot those before naked ones
+bool PuzzleGrader::findSingle(PuzzleStep& step) const {
+    static const int UNIT_ORDER[3] = { 18, 0, 9 };
+    for (int first : UNIT_ORDER) {
+        for (int unit = first; unit < first + N; ++unit) {
+            unsigned int once = 0, twice = 0;
+            for (uint8_t cell : tables.units[unit]) {
+                twice |= once & candidates[cell];
+                once |= candidates[cell];
+            }
+            unsigned int singles = once & ~twice;
+            if (!singles) continue;
+
+            int num = lowestBit(singles) + 1;
+            for (uint8_t cell : tables.units[unit]) {
+                if (candidates[cell] & digitBit(num)) {
+                    step.technique = Technique::HiddenSingle;
+                    step.cell = cell;
+                    step.digit = num;
+                    step.unit = unit;
+                    return true;
+                }
+            }
+        }
+    }
+
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (values[cell] == 0 && popCount(candidates[cell]) == 1) {
+            step.technique = Technique::NakedSingle;
+            step.cell = cell;
+            step.digit = lowestBit(candidates[cell]) + 1;
+            return true;
+        }
+    }
+    return false;
+}
+
+// The easiest technique beyond singles that removes a candidate
+bool PuzzleGrader::applyElimination(Technique& used) {
+    if (lockedCandidates()) used = Technique::LockedCandidates;
+    else if (nakedSubsets(2)) used = Technique::NakedPair;
+    else if (hiddenPairs()) used = Technique::HiddenPair;
+    else if (nakedSubsets(3)) used = Technique::NakedTriple;
+    else if (fish(2)) used = Technique::XWing;
+    else if (fish(3)) used = Technique::Swordfish;
+    else return false;
+    return true;
+}
+
+bool PuzzleGrader::hiddenSingles() {
+    bool progress = false;
+    for (int unit = 0; unit < UNITS; ++unit) {
+        unsigned int once = 0, twice = 0, placed = 0;
+        for (uint8_t cell : tables.units[unit]) {
+            twice |= once & candidates[cell];
+            once |= candidates[cell];
+            if (values[cell]) placed |= digitBit(values[cell]);
+        }
+        if ((once | placed) != ALL_DIGITS) {
+            contradiction = true; // some digit has nowhere to go
+            return true;
+        }
+
+        unsigned int singles = once & ~twice & ~placed;
+        while (singles) {
+            int num = lowestBit(singles) + 1;
+            singles &= singles - 1;
+            for (uint8_t cell : tables.units[unit]) {
+                if (candidates[cell] & digitBit(num)) {
+                    place(cell, num);
+                    progress = true;
+                    break;
+                }
+            }
+        }
+    }
+    return progress;
+}
+
+bool PuzzleGrader::nakedSingles() {
+    bool progress = false;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        if (values[cell] == 0 && popCount(candidates[cell]) == 1) {
+            place(cell, lowestBit(candidates[cell]) + 1);
+            progress = true;
+        }
+    }
+    return progress;
+}
+
+bool PuzzleGrader::lockedCandidates() {
+    for (int num = 1; num <= N; ++num) {
+        unsigned int bit = digitBit(num);
+
+        // Pointing: inside a box the digit is confined to one row or column
+        for (int box = 0; box < N; ++box) {
+            unsigned int rows = 0, cols = 0;
+            for (uint8_t cell : tables.units[18 + box]) {
+                if (candidates[cell] & bit) {
+                    rows |= 1u << (cell / 9);
+                    cols |= 1u << (cell % 9);
+                }
+            }
+            if (rows == 0) continue;
+
+            bool progress = false;
+            if (popCount(rows) == 1) {
+                for (uint8_t cell : tables.units[lowestBit(rows)]) {
+                    if ((cell / 9 / 3) * 3 + (cell % 9) / 3 != box) progress |= eliminate(cell, bit);
+                }
+            }
+            if (popCount(cols) == 1) {
+                for (uint8_t cell : tables.units[9 + lowestBit(cols)]) {
+                    if ((cell / 9 / 3) * 3 + (cell % 9) / 3 != box) progress |= eliminate(cell, bit);
+                }
+            }
+            if (progress) return true;
+        }
+
+        // Claiming: inside a row or column the digit is confined to one box
+        for (int line = 0; line < 18; ++line) {
+            unsigned int boxes = 0;
+            for (uint8_t cell : tables.units[line]) {
+                if (candidates[cell] & bit) boxes |= 1u << ((cell / 9 / 3) * 3 + (cell % 9) / 3);
+            }
+            if (popCount(boxes) != 1) continue;
+
+            bool progress = false;
+            for (uint8_t cell : tables.units[18 + lowestBit(boxes)]) {
+                bool onLine = (line < 9) ? cell / 9 == line : cell % 9 == line - 9;
+                if (!onLine) progress |= eliminate(cell, bit);
+            }
+            if (progress) return true;
+        }
+    }
+    return false;
+}
+
+bool PuzzleGrader::nakedSubsets(int size) {
+    for (int unit = 0; unit < UNITS; ++unit) {
+        uint8_t cells[9];
+        int count = 0;
+        for (uint8_t cell : tables.units[unit]) {
+            int options = popCount(candidates[cell]);
+            if (values[cell] == 0 && options >= 2 && options <= size) cells[count++] = cell;
+        }
+
+        bool found = forEachCombination(count, size, [&](const int* index) {
+            unsigned int combined = 0;
+            for (int i = 0; i < size; ++i) combined |= candidates[cells[index[i]]];
+            if (popCount(combined) != size) return false;
+
+            bool progress = false;
+            for (uint8_t cell : tables.units[unit]) {
+                bool inSubset = false;
+                for (int i = 0; i < size; ++i) inSubset |= cells[index[i]] == cell;
+                if (!inSubset) progress |= eliminate(cell, combined);
+            }
+            return progress;
+        });
+        if (found) return true;
+    }
+    return false;
+}
+
+bool PuzzleGrader::hiddenPairs() {
+    for (int unit = 0; unit < UNITS; ++unit) {
+        // positions[d] = bit i set if unit cell i can hold digit d + 1
+        unsigned int positions[N] = { 0 };
+        for (int i = 0; i < N; ++i) {
+            unsigned int mask = candidates[tables.units[unit][i]];
+            while (mask) {
+                positions[lowestBit(mask)] |= 1u << i;
+                mask &= mask - 1;
+            }
+        }
+
+        for (int first = 0; first < N; ++first) {
+            if (popCount(positions[first]) != 2) continue;
+            for (int second = first + 1; second < N; ++second) {
+                if (positions[second] != positions[first]) continue;
+
+                unsigned int others = ALL_DIGITS & ~((1u << first) | (1u << second));
+                bool progress = false;
+                unsigned int where = positions[first];
+                while (where) {
+                    progress |= eliminate(tables.units[unit][lowestBit(where)], others);
+                    where &= where - 1;
+                }
+                if (progress) return true;
+            }
+        }
+    }
+    return false;
+}
+
+bool PuzzleGrader::fish(int size) {
+    for (int num = 1; num <= N; ++num) {
+        unsigned int bit = digitBit(num);
+
+        // Rows as base lines first, then columns
+        for (int orientation = 0; orientation < 2; ++orientation) {
+            int lines[N];
+            unsigned int cover[N];
+            int count = 0;
+            for (int line = 0; line < N; ++line) {
+                unsigned int mask = 0;
+                for (int i = 0; i < N; ++i) {
+                    if (candidates[tables.units[orientation * 9 + line][i]] & bit) mask |= 1u << i;
+                }
+                int options = popCount(mask);
+                if (options >= 2 && options <= size) {
+                    lines[count] = line;
+                    cover[count++] = mask;
+                }
+            }
+
+            bool found = forEachCombination(count, size, [&](const int* index) {
+                unsigned int crossing = 0;
+                for (int i = 0; i < size; ++i) crossing |= cover[index[i]];
+                if (popCount(crossing) != size) return false;
+
+                // The digit sits on the crossing lines within the base lines, clear it elsewhere
+                bool progress = false;
+                for (unsigned int rest = crossing; rest; rest &= rest - 1) {
+                    int crossLine = (1 - orientation) * 9 + lowestBit(rest);
+                    // Position i along a crossing line lies on base line i
+                    for (int i = 0; i < N; ++i) {
+                        bool isBase = false;
+                        for (int k = 0; k < size; ++k) isBase |= lines[index[k]] == i;
+                        if (!isBase) progress |= eliminate(tables.units[crossLine][i], bit);
+                    }
+                }
+                return progress;
+            });
+            if (found) return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef PUZZLEGRADER_H
+#define PUZZLEGRADER_H
+
+#include <cstdint>
+
+#include "bitutils.h"
+
+// Human solving techniques, ordered from easiest to hardest
+enum class Technique : uint8_t {
+    None,               // nothing to deduce, the board was already full
+    HiddenSingle,
+    NakedSingle,
+    LockedCandidates,   // pointing and box/line claiming
+    NakedPair,
+    HiddenPair,
+    NakedTriple,
+    XWing,
+    Swordfish,
+    Guessing            // not solvable with the techniques above
+};
+
+struct PuzzleGrade {
+    Technique hardest = Technique::None;
+    int steps = 0;       // technique applications needed
+    bool solved = false; // false if logic alone got stuck or hit a contradiction
+};
+
+// The next placement a person would find on a partly filled board
+struct PuzzleStep {
+    Technique technique = Technique::None;  // the single that places digit, Guessing if logic is stuck
+    Technique preparedBy = Technique::None; // hardest elimination needed before the single shows up
+    int cell = -1;                          // when stuck, the empty cell with the fewest candidates
+    int digit = 0;                          // 0 when stuck
+    int unit = -1;                          // unit of a hidden single: rows 0-8, columns 9-17, boxes 18-26
+};
+
+// Rates a puzzle by solving it the way a person would: always apply the
+// easiest technique that makes progress, and score the hardest one needed.
+// Candidates are 9-bit masks per cell, so grading takes microseconds.
+class PuzzleGrader {
+public:
+    static const int N = 9;
+    static const int CELLS = N * N;
+
+    PuzzleGrade grade(const int board[N][N]);
+
+    // Easiest next placement, eliminating with the harder techniques only as
+    // long as no single is visible. Technique None if the board is full,
+    // conflicting or has no solution left.
+    PuzzleStep nextStep(const int board[N][N]);
+
+    static const char* techniqueName(Technique technique);
+
+private:
+    bool load(const int board[N][N]);
+    void place(int cell, int num);
+    bool eliminate(int cell, unsigned int mask);
+
+    bool findSingle(PuzzleStep& step) const;
+    bool applyElimination(Technique& used);
+
+    bool hiddenSingles();
+    bool nakedSingles();
+    bool lockedCandidates();
+    bool nakedSubsets(int size);
+    bool hiddenPairs();
+    bool fish(int size);
+
+    uint8_t values[CELLS];
+    uint16_t candidates[CELLS]; // 0 once a cell is solved
+    int unsolved = 0;
+    bool contradiction = false;
+};
+
+#endif // PUZZLEGRADER_H
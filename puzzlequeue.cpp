@@ -0,0 +1,85 @@
+#include "puzzlequeue.h"
+
+#include <QCoreApplication>
+
+// --- PuzzleWorker ---
+
+void PuzzleWorker::generate(int difficulty) {
+    GeneratedPuzzle puzzle;
+    puzzle.difficulty = difficulty;
+    puzzle.seed = sudokuLogic.newSeed();
+    sudokuLogic.generatePuzzle(puzzle.seed, difficulty, puzzle.board, puzzle.solution); // an empty board can always be filled
+    puzzle.stats = sudokuLogic.stats();
+
+    emit puzzleReady(puzzle);
+}
+
+// --- PuzzleQueue ---
+
+PuzzleQueue::PuzzleQueue(QObject* parent) : QObject(parent) {
+    qRegisterMetaType<GeneratedPuzzle>();
+    bank.open(getBankFilePath());
+
+    worker = new PuzzleWorker;
+    worker->moveToThread(&workerThread);
+    connect(&workerThread, &QThread::finished, worker, &QObject::deleteLater);
+    connect(this, &PuzzleQueue::requestGeneration, worker, &PuzzleWorker::generate);
+    connect(worker, &PuzzleWorker::puzzleReady, this, &PuzzleQueue::storePuzzle);
+    workerThread.start(QThread::LowPriority);
+
+    for (int difficulty = 1; difficulty <= DIFFICULTIES; ++difficulty) {
+        refill(difficulty);
+    }
+}
+
+PuzzleQueue::~PuzzleQueue() {
+    workerThread.quit();
+    workerThread.wait();
+}
+
+bool PuzzleQueue::takePuzzle(int difficulty, GeneratedPuzzle& puzzle) {
+    if (difficulty < 1 || difficulty > DIFFICULTIES) difficulty = 2;
+    QQueue<GeneratedPuzzle>& queue = ready[difficulty - 1];
+
+    if (bank.takePuzzle(difficulty, puzzle.seed, puzzle.board, puzzle.solution)) {
+        puzzle.difficulty = difficulty;
+        return true;
+    }
+
+    bool found = !queue.isEmpty();
+    if (found) puzzle = queue.dequeue();
+    refill(difficulty);
+
+    // refill leaves difficulties the bank still lists to the bank, make sure one is on the way
+    if (!found && inFlight[difficulty - 1] == 0) {
+        inFlight[difficulty - 1]++;
+        emit requestGeneration(difficulty);
+    }
+    return found;
+}
+
+int PuzzleQueue::readyCount(int difficulty) const {
+    if (difficulty < 1 || difficulty > DIFFICULTIES) return 0;
+    if (bank.count(difficulty) > 0) return bank.count(difficulty);
+    return ready[difficulty - 1].size();
+}
+
+QString PuzzleQueue::getBankFilePath() {
+    return QCoreApplication::applicationDirPath() + "/puzzles.bank";
+}
+
+void PuzzleQueue::storePuzzle(const GeneratedPuzzle& puzzle) {
+    int index = puzzle.difficulty - 1;
+    inFlight[index]--;
+    ready[index].enqueue(puzzle);
+    emit puzzleAvailable(puzzle.difficulty);
+}
+
+void PuzzleQueue::refill(int difficulty) {
+    if (bank.count(difficulty) > 0) return; // served from the bank, nothing to generate
+    int index = difficulty - 1;
+    while (ready[index].size() + inFlight[index] < QUEUE_DEPTH) {
+        inFlight[index]++;
+        emit requestGeneration(difficulty);
+    }
+}
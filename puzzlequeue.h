@@ -0,0 +1,74 @@
+#pragma once
+#ifndef PUZZLEQUEUE_H
+#define PUZZLEQUEUE_H
+
+#include <QObject>
+#include <QThread>
+#include <QQueue>
+#include <QMetaType>
+
+#include "sudokulogic.h"
+#include "puzzlebank.h"
+
+struct GeneratedPuzzle {
+    uint64_t seed = 0; // regenerates the puzzle with SudokuLogic::generatePuzzle
+    int difficulty = 0;
+    int board[SIZE][SIZE] = { 0 };
+    int solution[SIZE][SIZE] = { 0 };
+    SolverStats stats; // of the generatePuzzle call, zero for puzzles from the bank
+};
+Q_DECLARE_METATYPE(GeneratedPuzzle)
+
+// Lives on the generator thread and owns its own SudokuLogic.
+class PuzzleWorker : public QObject {
+    Q_OBJECT
+
+public slots:
+    void generate(int difficulty);
+
+signals:
+    void puzzleReady(const GeneratedPuzzle& puzzle);
+
+private:
+    SudokuLogic sudokuLogic;
+};
+
+// Hands out new puzzles without running the generator on the GUI thread.
+// Difficulties covered by the puzzle bank next to the executable are picked from
+// it directly; for the others a few pre-generated puzzles are kept ready and
+// refilled in the background.
+class PuzzleQueue : public QObject {
+    Q_OBJECT
+
+public:
+    static const int DIFFICULTIES = 4;  // 1=Easy, 2=Medium, 3=Hard, 4=Expert
+    static const int QUEUE_DEPTH = 3;   // ready puzzles kept per difficulty
+
+    explicit PuzzleQueue(QObject* parent = nullptr);
+    ~PuzzleQueue();
+
+    // Pops a ready puzzle. Returns false if none is ready yet; puzzleAvailable is
+    // emitted for that difficulty once one is.
+    bool takePuzzle(int difficulty, GeneratedPuzzle& puzzle);
+    int readyCount(int difficulty) const;
+
+    QString getBankFilePath();
+
+signals:
+    void puzzleAvailable(int difficulty);
+    void requestGeneration(int difficulty);
+
+private slots:
+    void storePuzzle(const GeneratedPuzzle& puzzle);
+
+private:
+    void refill(int difficulty);
+
+    PuzzleBank bank;
+    QThread workerThread;
+    PuzzleWorker* worker;
+    QQueue<GeneratedPuzzle> ready[DIFFICULTIES];
+    int inFlight[DIFFICULTIES] = { 0 };
+};
+
+#endif // PUZZLEQUEUE_H
@@ -0,0 +1,96 @@
+// Compares the binary save format against the legacy JSON one, in memory and
+// through a file in the temp directory.
+//
+// Usage: SaveBench [iterations]
+
+#include "savefile.h"
+#include "sudokulogic.h"
+
+#include <QDir>
+#include <QFile>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+
+static double timeUs(int iterations, const std::function<void()>& body) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) body();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / iterations;
+}
+
+int main(int argc, char* argv[]) {
+    int iterations = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 10000;
+
+    // A Medium game with every other empty cell filled in, each fill on the undo history
+    SudokuLogic logic;
+    SaveData save;
+    logic.generateFullBoard(save.solution);
+    std::copy(&save.solution[0][0], &save.solution[0][0] + SIZE * SIZE, &save.board[0][0]);
+    logic.removeNumbers(save.board, 2);
+    for (int i = 0; i < SIZE * SIZE; i += 2) {
+        if (save.board[i / SIZE][i % SIZE] != 0) continue;
+        save.userInputs[i / SIZE][i % SIZE] = save.solution[i / SIZE][i % SIZE];
+
+        MoveRecord move;
+        move.cell = static_cast<uint8_t>(i);
+        move.newValue = static_cast<uint8_t>(save.solution[i / SIZE][i % SIZE]);
+        move.source = static_cast<uint8_t>(JournalEntryType::CellEdit);
+        save.history.push(move);
+    }
+
+    const QString jsonPath = QDir::tempPath() + "/savebench.json";
+    const QString binaryPath = QDir::tempPath() + "/savebench.dat";
+    SaveData loaded;
+    bool allOk = true;
+
+    double jsonMemory = timeUs(iterations, [&] {
+        allOk &= decodeLegacyJson(encodeLegacyJson(save), loaded);
+    });
+    double binaryMemory = timeUs(iterations, [&] {
+        uint8_t data[SAVE_FILE_MAX_BYTES];
+        int size = encodeSave(save, data);
+        allOk &= decodeSave(data, size, loaded);
+    });
+
+    double jsonFile = timeUs(iterations, [&] {
+        QFile out(jsonPath);
+        out.open(QIODevice::WriteOnly);
+        out.write(encodeLegacyJson(save));
+        out.close();
+
+        QFile in(jsonPath);
+        in.open(QIODevice::ReadOnly);
+        allOk &= decodeLegacyJson(in.readAll(), loaded);
+    });
+    double binaryFile = timeUs(iterations, [&] {
+        uint8_t data[SAVE_FILE_MAX_BYTES];
+        int size = encodeSave(save, data);
+        QFile out(binaryPath);
+        out.open(QIODevice::WriteOnly);
+        out.write(reinterpret_cast<const char*>(data), size);
+        out.close();
+
+        QFile in(binaryPath);
+        in.open(QIODevice::ReadOnly);
+        qint64 bytesRead = in.read(reinterpret_cast<char*>(data), SAVE_FILE_MAX_BYTES);
+        allOk &= decodeSave(data, bytesRead, loaded);
+    });
+
+    std::printf("%-8s %10s %16s %16s\n", "format", "bytes", "memory us/op", "file us/op");
+    std::printf("%-8s %10d %16.2f %16.2f\n", "json", static_cast<int>(encodeLegacyJson(save).size()), jsonMemory, jsonFile);
+    uint8_t encoded[SAVE_FILE_MAX_BYTES];
+    std::printf("%-8s %10d %16.2f %16.2f\n", "binary", encodeSave(save, encoded), binaryMemory, binaryFile);
+    std::printf("speedup  %27.1fx %15.1fx\n", jsonMemory / binaryMemory, jsonFile / binaryFile);
+
+    QFile::remove(jsonPath);
+    QFile::remove(binaryPath);
+    if (!allOk) {
+        std::printf("error: a round trip failed\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,378 @@
+#include "savefile.h"
+#include "bitutils.h"
+#include "boardtables.h"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+
+#include <algorithm>
+
+namespace {
+
+const uint8_t SAVE_MAGIC[4] = { 'S', 'D', 'K', 'S' };
+const uint8_t JOURNAL_MAGIC[4] = { 'S', 'D', 'K', 'J' };
+const int JOURNAL_VERSION = 1;
+const int SEED_OFFSET = 8;
+const uint8_t FLAG_NOTES = 0x01;
+const int NOTE_BITS = 9;
+
+// Section offsets, versions before 3 have no seed and start the boards at byte 8
+struct SaveLayout {
+    int solution;
+    int givenMask;
+    int inputs;
+    int history; // version 1: checksum
+};
+
+SaveLayout layoutFor(int version) {
+    SaveLayout layout;
+    layout.solution = (version >= 3) ? SEED_OFFSET + 8 : SEED_OFFSET;
+    layout.givenMask = layout.solution + PACKED_BOARD_BYTES;
+    layout.inputs = layout.givenMask + GIVEN_MASK_BYTES;
+    layout.history = layout.inputs + PACKED_BOARD_BYTES;
+    return layout;
+}
+
+uint32_t fnv1a(const uint8_t* data, int size) {
+    uint32_t hash = 2166136261u;
+    for (int i = 0; i < size; ++i) {
+        hash ^= data[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+void writeUint16(uint8_t* out, int value) {
+    out[0] = static_cast<uint8_t>(value);
+    out[1] = static_cast<uint8_t>(value >> 8);
+}
+
+int readUint16(const uint8_t* data) {
+    return data[0] | (data[1] << 8);
+}
+
+void writeUint64(uint8_t* out, uint64_t value) {
+    for (int i = 0; i < 8; ++i) out[i] = static_cast<uint8_t>(value >> (8 * i));
+}
+
+uint64_t readUint64(const uint8_t* data) {
+    uint64_t value = 0;
+    for (int i = 0; i < 8; ++i) value |= static_cast<uint64_t>(data[i]) << (8 * i);
+    return value;
+}
+
+uint32_t readUint32(const uint8_t* data) {
+    uint32_t value = 0;
+    for (int i = 0; i < 4; ++i) value |= static_cast<uint32_t>(data[i]) << (8 * i);
+    return value;
+}
+
+// Cells with notes as a cell bitmask, then their 9-bit masks back to back
+int packNotes(const uint16_t notes[9][9], uint8_t* out) {
+    for (int i = 0; i < SAVE_NOTES_MAX_BYTES; ++i) out[i] = 0;
+    int bit = 0;
+    for (int cell = 0; cell < 81; ++cell) {
+        unsigned int mask = notes[cell / 9][cell % 9] & ALL_DIGITS;
+        if (mask == 0) continue;
+        out[cell / 8] |= static_cast<uint8_t>(1 << (cell % 8));
+        for (int i = 0; i < NOTE_BITS; ++i, ++bit) {
+            if (mask & (1u << i)) out[GIVEN_MASK_BYTES + bit / 8] |= static_cast<uint8_t>(1 << (bit % 8));
+        }
+    }
+    return GIVEN_MASK_BYTES + (bit + 7) / 8;
+}
+
+// Size of the notes section starting at data, 0 if fewer than available bytes hold it
+int notesBytes(const uint8_t* data, int64_t available) {
+    if (available < GIVEN_MASK_BYTES) return 0;
+    int noted = 0;
+    for (int i = 0; i < GIVEN_MASK_BYTES; ++i) noted += popCount(data[i]);
+    int bytes = GIVEN_MASK_BYTES + (noted * NOTE_BITS + 7) / 8;
+    return bytes <= available ? bytes : 0;
+}
+
+void unpackNotes(const uint8_t* data, uint16_t notes[9][9]) {
+    int bit = 0;
+    for (int cell = 0; cell < 81; ++cell) {
+        uint16_t mask = 0;
+        if (isGivenCell(data, cell)) {
+            for (int i = 0; i < NOTE_BITS; ++i, ++bit) {
+                if ((data[GIVEN_MASK_BYTES + bit / 8] >> (bit % 8)) & 1) mask |= static_cast<uint16_t>(1 << i);
+            }
+        }
+        notes[cell / 9][cell % 9] = mask;
+    }
+}
+
+// Sets a player entry the way BoardModel::setValue does, pruning the notes
+void setInput(SaveData& save, int cell, int value) {
+    save.userInputs[cell / 9][cell % 9] = value;
+    if (value == 0) return;
+    uint16_t keep = static_cast<uint16_t>(~digitBit(value));
+    save.notes[cell / 9][cell % 9] = 0;
+    for (int peer : CLASSIC_TABLES.peers[cell]) save.notes[peer / 9][peer % 9] &= keep;
+}
+
+QJsonArray gridToJson(const int grid[9][9]) {
+    QJsonArray gridArray;
+    for (int row = 0; row < 9; row++) {
+        QJsonArray rowArray;
+        for (int col = 0; col < 9; col++) {
+            rowArray.append(grid[row][col]);
+        }
+        gridArray.append(rowArray);
+    }
+    return gridArray;
+}
+
+bool gridFromJson(const QJsonValue& value, int grid[9][9]) {
+    if (!value.isArray()) return false;
+    QJsonArray gridArray = value.toArray();
+    if (gridArray.size() != 9) return false;
+
+    for (int row = 0; row < 9; row++) {
+        if (!gridArray[row].isArray() || gridArray[row].toArray().size() != 9) return false;
+        QJsonArray rowArray = gridArray[row].toArray();
+        for (int col = 0; col < 9; col++) {
+            grid[row][col] = rowArray[col].toInt(0); // Default to 0 if invalid
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int encodeSave(const SaveData& save, uint8_t out[SAVE_FILE_MAX_BYTES]) {
+    const SaveLayout layout = layoutFor(SAVE_FORMAT_VERSION);
+    for (int i = 0; i < layout.history + 4; ++i) out[i] = 0;
+
+    for (int i = 0; i < 4; ++i) out[i] = SAVE_MAGIC[i];
+    out[4] = SAVE_FORMAT_VERSION;
+    writeUint64(out + SEED_OFFSET, save.seed);
+
+    packBoard(save.solution, out + layout.solution);
+    packGivenMask(save.board, out + layout.givenMask);
+
+    int inputs[9][9];
+    for (int i = 0; i < 81; ++i) {
+        int row = i / 9, col = i % 9;
+        inputs[row][col] = (save.board[row][col] != 0) ? 0 : save.userInputs[row][col];
+    }
+    packBoard(inputs, out + layout.inputs);
+
+    // Notes only on empty, non-given cells
+    uint16_t notes[9][9];
+    bool hasNotes = false;
+    for (int i = 0; i < 81; ++i) {
+        int row = i / 9, col = i % 9;
+        notes[row][col] = (save.board[row][col] == 0 && inputs[row][col] == 0) ? save.notes[row][col] & ALL_DIGITS : 0;
+        hasNotes = hasNotes || notes[row][col] != 0;
+    }
+    if (hasNotes) out[5] |= FLAG_NOTES;
+
+    const MoveHistory& history = save.history;
+    writeUint16(out + layout.history, history.size());
+    writeUint16(out + layout.history + 2, history.position());
+    uint8_t* record = out + layout.history + 4;
+    for (int i = 0; i < history.size(); ++i, record += 4) {
+        const MoveRecord& move = history.at(i);
+        record[0] = move.cell;
+        record[1] = move.oldValue;
+        record[2] = move.newValue;
+        record[3] = move.source;
+    }
+    if (hasNotes) record += packNotes(notes, record);
+
+    int checksumOffset = static_cast<int>(record - out);
+    uint32_t checksum = fnv1a(out, checksumOffset);
+    for (int i = 0; i < 4; ++i) out[checksumOffset + i] = static_cast<uint8_t>(checksum >> (8 * i));
+    return checksumOffset + 4;
+}
+
+bool decodeSave(const uint8_t* data, int64_t size, SaveData& save, uint32_t* checksum) {
+    const SaveLayout v1 = layoutFor(1);
+    if (size < v1.history + 4) return false;
+    for (int i = 0; i < 4; ++i) {
+        if (data[i] != SAVE_MAGIC[i]) return false;
+    }
+
+    const int version = data[4];
+    if (version < 1 || version > SAVE_FORMAT_VERSION) return false;
+    const SaveLayout layout = layoutFor(version);
+
+    int fileBytes = layout.history + 4;
+    int moveCount = 0;
+    int applied = 0;
+    int notesOffset = 0;
+    if (version >= 2) {
+        if (size < layout.history + 8) return false;
+        moveCount = readUint16(data + layout.history);
+        applied = readUint16(data + layout.history + 2);
+        if (moveCount > MoveHistory::CAPACITY) return false;
+        fileBytes = layout.history + 4 + moveCount * 4 + 4;
+    }
+    if (version >= 4 && (data[5] & FLAG_NOTES)) {
+        notesOffset = fileBytes - 4;
+        int bytes = notesBytes(data + notesOffset, size - notesOffset);
+        if (bytes == 0) return false;
+        fileBytes += bytes;
+    }
+    if (size < fileBytes) return false;
+
+    uint32_t storedChecksum = saveChecksum(data, fileBytes);
+    if (storedChecksum != fnv1a(data, fileBytes - 4)) return false;
+    if (checksum) *checksum = storedChecksum;
+
+    save.seed = (version >= 3) ? readUint64(data + SEED_OFFSET) : 0;
+    if (!unpackBoard(data + layout.solution, save.solution)) return false;
+    if (!unpackBoard(data + layout.inputs, save.userInputs)) return false;
+
+    MoveRecord moves[MoveHistory::CAPACITY];
+    const uint8_t* record = data + layout.history + 4;
+    for (int i = 0; i < moveCount; ++i, record += 4) {
+        moves[i].cell = record[0];
+        moves[i].oldValue = record[1];
+        moves[i].newValue = record[2];
+        moves[i].source = record[3];
+        if (moves[i].cell > 80 || moves[i].oldValue > 9 || moves[i].newValue > 9) return false;
+    }
+    if (!save.history.restore(moves, moveCount, applied)) return false;
+
+    if (notesOffset != 0) unpackNotes(data + notesOffset, save.notes);
+    else std::fill(&save.notes[0][0], &save.notes[0][0] + 81, static_cast<uint16_t>(0));
+
+    for (int i = 0; i < 81; ++i) {
+        int row = i / 9, col = i % 9;
+        bool given = isGivenCell(data + layout.givenMask, i);
+        save.board[row][col] = given ? save.solution[row][col] : 0;
+        if (given) save.userInputs[row][col] = 0;
+        if (given || save.userInputs[row][col] != 0) save.notes[row][col] = 0;
+    }
+    return true;
+}
+
+uint32_t saveChecksum(const uint8_t* data, int size) {
+    return readUint32(data + size - 4);
+}
+
+void encodeJournalHeader(uint32_t snapshotChecksum, uint8_t out[JOURNAL_HEADER_BYTES]) {
+    for (int i = 0; i < JOURNAL_HEADER_BYTES; ++i) out[i] = 0;
+    for (int i = 0; i < 4; ++i) out[i] = JOURNAL_MAGIC[i];
+    out[4] = JOURNAL_VERSION;
+    for (int i = 0; i < 4; ++i) out[8 + i] = static_cast<uint8_t>(snapshotChecksum >> (8 * i));
+}
+
+bool decodeJournalHeader(const uint8_t* data, int64_t size, uint32_t& snapshotChecksum) {
+    if (size < JOURNAL_HEADER_BYTES) return false;
+    for (int i = 0; i < 4; ++i) {
+        if (data[i] != JOURNAL_MAGIC[i]) return false;
+    }
+    if (data[4] != JOURNAL_VERSION) return false;
+
+    snapshotChecksum = readUint32(data + 8);
+    return true;
+}
+
+void encodeJournalRecord(JournalEntryType type, int cell, int value, uint8_t out[JOURNAL_RECORD_BYTES]) {
+    out[0] = static_cast<uint8_t>(type);
+    out[1] = static_cast<uint8_t>(cell);
+    out[2] = static_cast<uint8_t>(value);
+    out[3] = static_cast<uint8_t>(out[0] ^ out[1] ^ out[2] ^ 0xA5);
+}
+
+bool applyJournalRecord(const uint8_t record[JOURNAL_RECORD_BYTES], SaveData& save) {
+    if (record[3] != static_cast<uint8_t>(record[0] ^ record[1] ^ record[2] ^ 0xA5)) return false;
+    int cell = record[1];
+    int value = record[2];
+    if (cell > 80 || value > 9) return false;
+
+    int& input = save.userInputs[cell / 9][cell % 9];
+    MoveRecord move;
+    switch (static_cast<JournalEntryType>(record[0])) {
+    case JournalEntryType::CellEdit:
+    case JournalEntryType::Hint:
+        if (save.board[cell / 9][cell % 9] != 0 || input == value) return true;
+        move.cell = static_cast<uint8_t>(cell);
+        move.oldValue = static_cast<uint8_t>(input);
+        move.newValue = static_cast<uint8_t>(value);
+        move.source = record[0];
+        save.history.push(move);
+        setInput(save, cell, value);
+        return true;
+    case JournalEntryType::Reset:
+        for (int i = 0; i < 81; ++i) {
+            save.userInputs[i / 9][i % 9] = 0;
+            save.notes[i / 9][i % 9] = 0;
+        }
+        save.history.clear();
+        return true;
+    case JournalEntryType::Undo:
+        if (!save.history.undo(move)) return false;
+        if (move.cell != cell) {
+            save.history.redo(move); // out of step with the history, leave it untouched
+            return false;
+        }
+        setInput(save, cell, move.oldValue);
+        return true;
+    case JournalEntryType::Redo:
+        if (!save.history.redo(move)) return false;
+        if (move.cell != cell) {
+            save.history.undo(move);
+            return false;
+        }
+        setInput(save, cell, move.newValue);
+        return true;
+    case JournalEntryType::Note:
+        if (value == 0) return false;
+        if (save.board[cell / 9][cell % 9] == 0 && input == 0) save.notes[cell / 9][cell % 9] ^= static_cast<uint16_t>(digitBit(value));
+        return true;
+    }
+    return false;
+}
+
+QByteArray encodeLegacyJson(const SaveData& save) {
+    QJsonObject gameState;
+    gameState["board"] = gridToJson(save.board);
+    gameState["solution"] = gridToJson(save.solution);
+
+    int inputs[9][9];
+    for (int row = 0; row < 9; row++) {
+        for (int col = 0; col < 9; col++) {
+            inputs[row][col] = save.board[row][col] == 0 ? save.userInputs[row][col] : 0;
+        }
+    }
+    gameState["userInputs"] = gridToJson(inputs);
+    gameState["timestamp"] = QDateTime::currentDateTime().toString(Qt::ISODate);
+
+    return QJsonDocument(gameState).toJson();
+}
+
+bool decodeLegacyJson(const QByteArray& json, SaveData& save) {
+    QJsonDocument doc = QJsonDocument::fromJson(json);
+    if (doc.isNull() || !doc.isObject()) {
+        qDebug() << "Invalid JSON format in save file.";
+        return false;
+    }
+    QJsonObject gameState = doc.object();
+
+    if (!gridFromJson(gameState["board"], save.board)) {
+        qDebug() << "Missing or invalid 'board' array in save file";
+        return false;
+    }
+    if (!gridFromJson(gameState["solution"], save.solution)) {
+        qDebug() << "Missing or invalid 'solution' array in save file";
+        return false;
+    }
+    // Older saves may lack inputs, that just means nothing was entered
+    if (!gridFromJson(gameState["userInputs"], save.userInputs)) {
+        for (int row = 0; row < 9; row++) {
+            for (int col = 0; col < 9; col++) {
+                save.userInputs[row][col] = 0;
+            }
+        }
+    }
+    return true;
+}
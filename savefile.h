@@ -0,0 +1,77 @@
+#pragma once
+#ifndef SAVEFILE_H
+#define SAVEFILE_H
+
+#include <QByteArray>
+#include <cstdint>
+
+#include "boardpacking.h"
+#include "movehistory.h"
+
+// Binary save layout, version 4 (117 bytes plus 4 per history move, plus notes):
+//   0   magic "SDKS"
+//   4   format version
+//   5   flags, bit 0 = a pencil-mark section follows the history
+//   6   reserved (2 bytes, 0)
+//   8   puzzle seed, little-endian (8 bytes), 0 = not generated from a seed
+//   16  solution, nibble-packed (41 bytes)
+//   57  given-cell bitmask, bit i = cell i is part of the puzzle (11 bytes)
+//   68  user inputs, nibble-packed, 0 = empty (41 bytes)
+//   109 undo history: move count, applied count (2 bytes each, little-endian),
+//       then count move records of 4 bytes (cell, old value, new value, source)
+//   ... pencil marks, only with flag bit 0: bitmask of the cells with notes
+//       (11 bytes), then 9 bits per such cell, low bit first (up to 92 bytes)
+//   end FNV-1a checksum of every byte before it, little-endian (4 bytes)
+// Version 3 has no notes. Versions 1 and 2 have no seed, the solution starts
+// at byte 8. Version 1 files also have no history and end with the checksum at byte 101.
+const int SAVE_FORMAT_VERSION = 4;
+const int SAVE_FILE_BYTES = 16 + PACKED_BOARD_BYTES + GIVEN_MASK_BYTES + PACKED_BOARD_BYTES + 4 + 4;
+const int SAVE_NOTES_MAX_BYTES = GIVEN_MASK_BYTES + (81 * 9 + 7) / 8;
+const int SAVE_FILE_MAX_BYTES = SAVE_FILE_BYTES + MoveHistory::CAPACITY * 4 + SAVE_NOTES_MAX_BYTES;
+
+struct SaveData {
+    int board[9][9] = { { 0 } };       // puzzle givens, 0 = empty
+    int solution[9][9] = { { 0 } };
+    int userInputs[9][9] = { { 0 } };  // player entries in non-given cells, 0 = empty
+    uint16_t notes[9][9] = { { 0 } };  // pencil marks of empty cells, bit d - 1 for digit d
+    MoveHistory history;
+    uint64_t seed = 0;                 // SudokuLogic::generatePuzzle seed, 0 for custom puzzles
+};
+
+// Returns the number of bytes written, at most SAVE_FILE_MAX_BYTES.
+int encodeSave(const SaveData& save, uint8_t out[SAVE_FILE_MAX_BYTES]);
+// Validates magic, version, checksum and cell values. No allocations.
+// The stored checksum is written to checksum when it is non-null.
+bool decodeSave(const uint8_t* data, int64_t size, SaveData& save, uint32_t* checksum = nullptr);
+// Checksum stored at the end of an encoded save of the given size
+uint32_t saveChecksum(const uint8_t* data, int size);
+
+// Move journal appended next to the snapshot between compactions:
+//   header  magic "SDKJ", version, 3 reserved bytes, checksum of the snapshot it extends
+//   records type, cell (0-80), value (0-9), type ^ cell ^ value ^ 0xA5
+// A torn or corrupted record ends the replay. Edits and hints are pushed onto
+// the undo history, undo and redo step through it, a reset clears it. Note
+// toggles pencil mark value (1-9) of the cell and is not part of the history.
+// Placing a digit prunes the notes the same way BoardModel::setValue does.
+enum class JournalEntryType : uint8_t {
+    CellEdit = 1,
+    Hint = 2,
+    Reset = 3,
+    Undo = 4,
+    Redo = 5,
+    Note = 6
+};
+const int JOURNAL_HEADER_BYTES = 12;
+const int JOURNAL_RECORD_BYTES = 4;
+
+void encodeJournalHeader(uint32_t snapshotChecksum, uint8_t out[JOURNAL_HEADER_BYTES]);
+bool decodeJournalHeader(const uint8_t* data, int64_t size, uint32_t& snapshotChecksum);
+void encodeJournalRecord(JournalEntryType type, int cell, int value, uint8_t out[JOURNAL_RECORD_BYTES]);
+// Applies a record to save. Returns false if the record is corrupt.
+bool applyJournalRecord(const uint8_t record[JOURNAL_RECORD_BYTES], SaveData& save);
+
+// Pretty-printed JSON format used before the binary one, still read for migration
+QByteArray encodeLegacyJson(const SaveData& save);
+bool decodeLegacyJson(const QByteArray& json, SaveData& save);
+
+#endif // SAVEFILE_H
@@ -0,0 +1,82 @@
+#include "simdboard.h"
+#include "boardtables.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define SIMDBOARD_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SIMDBOARD_SSE2
+#endif
+
+namespace {
+
+const int LANES = 32;
+const int USED_LANES = ClassicBoard::UNITS;
+
+} // namespace
+
+void packUnitLanes(const int board[9][9], UnitLanes& packed) {
+    const int* cells = &board[0][0];
+    for (int i = 0; i < 9; ++i) {
+        for (int unit = 0; unit < USED_LANES; ++unit) {
+            packed.lanes[i][unit] = static_cast<uint8_t>(cells[CLASSIC_TABLES.units[unit][i]]);
+        }
+        for (int lane = USED_LANES; lane < LANES; ++lane) packed.lanes[i][lane] = 0;
+    }
+}
+
+#if defined(SIMDBOARD_AVX2)
+
+bool unitsConflictFree(const UnitLanes& packed) {
+    __m256i v[9];
+    for (int i = 0; i < 9; ++i) v[i] = _mm256_load_si256(reinterpret_cast<const __m256i*>(packed.lanes[i]));
+
+    // A lane is a duplicate if position i and a later position j hold the same non-zero digit
+    const __m256i zero = _mm256_setzero_si256();
+    __m256i duplicates = zero;
+    for (int i = 0; i < 8; ++i) {
+        __m256i empty = _mm256_cmpeq_epi8(v[i], zero);
+        for (int j = i + 1; j < 9; ++j) {
+            duplicates = _mm256_or_si256(duplicates, _mm256_andnot_si256(empty, _mm256_cmpeq_epi8(v[i], v[j])));
+        }
+    }
+    return _mm256_testz_si256(duplicates, duplicates) != 0;
+}
+
+#elif defined(SIMDBOARD_SSE2)
+
+// Lanes 0-15 and 16-31 as two 128-bit halves
+bool unitsConflictFree(const UnitLanes& packed) {
+    const __m128i zero = _mm_setzero_si128();
+    __m128i duplicates = zero;
+    for (int half = 0; half < 2; ++half) {
+        __m128i v[9];
+        for (int i = 0; i < 9; ++i) v[i] = _mm_load_si128(reinterpret_cast<const __m128i*>(packed.lanes[i] + 16 * half));
+
+        for (int i = 0; i < 8; ++i) {
+            __m128i empty = _mm_cmpeq_epi8(v[i], zero);
+            for (int j = i + 1; j < 9; ++j) {
+                duplicates = _mm_or_si128(duplicates, _mm_andnot_si128(empty, _mm_cmpeq_epi8(v[i], v[j])));
+            }
+        }
+    }
+    return _mm_movemask_epi8(duplicates) == 0;
+}
+
+#else
+
+bool unitsConflictFree(const UnitLanes& packed) {
+    for (int unit = 0; unit < USED_LANES; ++unit) {
+        unsigned int seen = 0;
+        for (int i = 0; i < 9; ++i) {
+            int value = packed.lanes[i][unit];
+            if (value == 0) continue;
+            if (seen & (1u << value)) return false;
+            seen |= 1u << value;
+        }
+    }
+    return true;
+}
+
+#endif
@@ -0,0 +1,23 @@
+#pragma once
+#ifndef SIMDBOARD_H
+#define SIMDBOARD_H
+
+#include <cstdint>
+
+// Whole-board checks in a handful of vector instructions. The board is packed
+// unit-major: lanes[i][u] holds the i-th cell of unit u (rows 0-8, columns
+// 9-17, boxes 18-26 as in boardtables.h), lanes 27-31 stay 0. Every unit then
+// sits in one column of a 9 x 32 byte block, so comparing lane vector i with
+// lane vector j checks the same pair of positions in all 27 units at once.
+// Uses AVX2 when the compiler targets it, SSE2 otherwise, with a scalar
+// fallback for other CPUs.
+struct UnitLanes {
+    alignas(32) uint8_t lanes[9][32];
+};
+
+void packUnitLanes(const int board[9][9], UnitLanes& packed);
+
+// True if no digit appears twice in a row, column or box. Empty cells are ignored.
+bool unitsConflictFree(const UnitLanes& packed);
+
+#endif // SIMDBOARD_H
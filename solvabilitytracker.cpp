@@ -0,0 +1,80 @@
+#include "solvabilitytracker.h"
+#include "boardtables.h"
+
+#include <algorithm>
+
+void SolvabilityTracker::load(const int board[N][N], const int solution[N][N]) {
+    std::fill(&unitCount[0][0], &unitCount[0][0] + ClassicBoard::UNITS * (N + 1), 0);
+    duplicates = 0;
+    searchCount = 0;
+    for (int cell = 0; cell < ClassicBoard::CELLS; ++cell) {
+        values[cell / N][cell % N] = board[cell / N][cell % N];
+        count(cell, board[cell / N][cell % N], 1);
+    }
+
+    solverStale = duplicates > 0;
+    if (solverStale) {
+        solvable = false;
+        return;
+    }
+    solver.load(values);
+
+    // The solution is a witness only if every filled cell agrees with it, restored entries may not
+    bool fits = solution != nullptr && solution[0][0] != 0;
+    for (int cell = 0; fits && cell < ClassicBoard::CELLS; ++cell) {
+        int value = values[cell / N][cell % N];
+        fits = value == 0 || value == solution[cell / N][cell % N];
+    }
+    if (fits) {
+        std::copy(&solution[0][0], &solution[0][0] + N * N, &witness[0][0]);
+        solvable = true;
+    }
+    else {
+        search();
+    }
+}
+
+bool SolvabilityTracker::setValue(int row, int col, int value) {
+    int old = values[row][col];
+    if (old == value) return solvable;
+
+    int cell = row * N + col;
+    count(cell, old, -1);
+    count(cell, value, 1);
+    values[row][col] = value;
+
+    if (duplicates > 0) {
+        // The solver's masks cannot hold a digit twice, catch up once the duplicate is gone
+        solverStale = true;
+        solvable = false;
+        return solvable;
+    }
+    if (solverStale) {
+        solver.load(values);
+        solverStale = false;
+    }
+    else {
+        solver.unplace(row, col);
+        if (value != 0) solver.place(row, col, value);
+    }
+
+    bool decided = (solvable && (value == 0 || witness[row][col] == value)) // witness still fits
+        || (!solvable && old == 0);                                          // only constraints were added
+    if (!decided) search();
+    return solvable;
+}
+
+// Adds delta to the count of value in the row, column and box of cell
+void SolvabilityTracker::count(int cell, int value, int delta) {
+    if (value == 0) return;
+    for (uint8_t unit : CLASSIC_TABLES.unitsOfCell[cell]) {
+        if (delta > 0 && unitCount[unit][value]++ > 0) duplicates++;
+        if (delta < 0 && --unitCount[unit][value] > 0) duplicates--;
+    }
+}
+
+bool SolvabilityTracker::search() {
+    searchCount++;
+    solvable = solver.countSolutions(1, witness) > 0;
+    return solvable;
+}
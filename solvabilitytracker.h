@@ -0,0 +1,47 @@
+#pragma once
+#ifndef SOLVABILITYTRACKER_H
+#define SOLVABILITYTRACKER_H
+
+#include <cstdint>
+
+#include "boardsize.h"
+#include "candidatesolver.h"
+
+// Follows the player's board one edit at a time and answers whether it can
+// still be completed. The candidate solver's row, column and box masks are
+// updated per edit rather than reloaded, and the last completion found is
+// kept as a witness, so most edits are decided without a search:
+//   a digit that agrees with the witness       still solvable
+//   clearing a cell of a solvable board        still solvable
+//   a new digit on an unsolvable board         still unsolvable
+//   a duplicate in a row, column or box        unsolvable
+// Only the remaining edits search, from the masks already in place.
+class SolvabilityTracker {
+public:
+    static const int N = ClassicBoard::N;
+
+    // Starts over with board. A known solution (not all zeros) becomes the first witness
+    // when every filled cell agrees with it, otherwise the board is searched.
+    void load(const int board[N][N], const int solution[N][N] = nullptr);
+
+    // Sets (row, col), 0 clears it. Returns isSolvable() afterwards.
+    bool setValue(int row, int col, int value);
+
+    bool isSolvable() const { return solvable; }
+    int searches() const { return searchCount; } // edits that needed the solver since load
+
+private:
+    void count(int cell, int value, int delta);
+    bool search();
+
+    CandidateSolver solver; // mirrors values while there are no duplicates
+    int values[N][N];
+    int witness[N][N];      // a completion of values while solvable
+    uint8_t unitCount[ClassicBoard::UNITS][N + 1];
+    int duplicates = 0;     // digits placed more than once in a unit
+    bool solverStale = false;
+    bool solvable = false;
+    int searchCount = 0;
+};
+
+#endif // SOLVABILITYTRACKER_H
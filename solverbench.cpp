@@ -0,0 +1,92 @@
+// Compares the solver backends behind SudokuLogic::countSolutions on a few puzzle classes.
+//
+// Usage: SolverBench [puzzles-per-class] [--all]
+//   --all also runs the reference backtracker on the minimal-clue classes,
+//   where it can take minutes per puzzle.
+//   Builds with SUDOKU_SOLVER_STATS add the average search nodes and the
+//   deepest search level per backend.
+
+#include "sudokulogic.h"
+#include "benchcorpus.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+static const char* backendName(SolverBackend backend) {
+    switch (backend) {
+    case SolverBackend::Backtracking: return "backtracking";
+    case SolverBackend::Candidates: return "candidates";
+    case SolverBackend::DancingLinks: return "dancing-links";
+    }
+    return "?";
+}
+
+int main(int argc, char* argv[]) {
+    int perClass = 50;
+    bool runAll = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--all") == 0) runAll = true;
+        else perClass = std::max(1, std::atoi(argv[i]));
+    }
+
+    SudokuLogic logic;
+    std::vector<PuzzleClass> classes;
+    classes.push_back(generatedClass(logic, "generated-easy", 1, perClass));
+    classes.push_back(generatedClass(logic, "generated-medium", 2, perClass));
+    classes.push_back(generatedClass(logic, "generated-hard", 3, perClass));
+
+    classes.push_back(seventeenClueClass());
+    classes.push_back(hardestKnownClass());
+
+    const SolverBackend backends[] = { SolverBackend::Backtracking, SolverBackend::Candidates, SolverBackend::DancingLinks };
+
+    std::printf("%-18s %-14s %8s %12s %12s", "class", "backend", "puzzles", "avg us", "max us");
+    if (SOLVER_STATS_ENABLED) std::printf(" %12s %9s", "avg nodes", "max depth");
+    std::printf("\n");
+    for (const PuzzleClass& pc : classes) {
+        double bestAvg = -1;
+        const char* winner = "";
+
+        for (SolverBackend backend : backends) {
+            if (backend == SolverBackend::Backtracking && pc.pathological && !runAll) {
+                std::printf("%-18s %-14s %8s\n", pc.name.c_str(), backendName(backend), "skipped");
+                continue;
+            }
+            logic.setSolverBackend(backend);
+
+            double total = 0, worst = 0;
+            logic.resetStats();
+            for (const BenchPuzzle& p : pc.puzzles) {
+                BenchPuzzle copy = p;
+                auto start = std::chrono::steady_clock::now();
+                int count = logic.countSolutions(copy.cells, 2);
+                auto end = std::chrono::steady_clock::now();
+                if (count != 1) std::printf("warning: %s found %d solutions\n", backendName(backend), count);
+
+                double us = std::chrono::duration<double, std::micro>(end - start).count();
+                total += us;
+                worst = std::max(worst, us);
+            }
+
+            double avg = total / pc.puzzles.size();
+            std::printf("%-18s %-14s %8zu %12.1f %12.1f", pc.name.c_str(), backendName(backend), pc.puzzles.size(), avg, worst);
+            if (SOLVER_STATS_ENABLED) {
+                const SolverStats& stats = logic.stats();
+                std::printf(" %12.0f", static_cast<double>(stats.nodes) / pc.puzzles.size());
+                if (backend == SolverBackend::Backtracking) std::printf(" %9s", "-");
+                else std::printf(" %9d", stats.maxDepth);
+            }
+            std::printf("\n");
+            if (bestAvg < 0 || avg < bestAvg) {
+                bestAvg = avg;
+                winner = backendName(backend);
+            }
+        }
+        std::printf("%-18s winner: %s\n\n", pc.name.c_str(), winner);
+    }
+    return 0;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef SOLVERSTATS_H
+#define SOLVERSTATS_H
+
+#include <algorithm>
+#include <chrono>
+
+// What the generator and the solvers spent on a call. The counters are only
+// updated when SUDOKU_SOLVER_STATS is defined; otherwise every SOLVER_STAT
+// statement compiles to nothing and the struct stays zero.
+struct SolverStats {
+    long long nodes = 0;            // search nodes visited
+    long long backtracks = 0;       // dead ends the search backed out of
+    int maxDepth = 0;               // deepest search level, not tracked by the reference backtracker
+    long long uniquenessChecks = 0; // removals tried by the digger
+    int attempts = 0;               // boards filled and dug by generatePuzzle
+    double fillMs = 0;              // wall time per generatePuzzle phase
+    double digMs = 0;
+    double gradeMs = 0;
+
+    void add(const SolverStats& other) {
+        nodes += other.nodes;
+        backtracks += other.backtracks;
+        maxDepth = std::max(maxDepth, other.maxDepth);
+        uniquenessChecks += other.uniquenessChecks;
+        attempts += other.attempts;
+        fillMs += other.fillMs;
+        digMs += other.digMs;
+        gradeMs += other.gradeMs;
+    }
+};
+
+#ifdef SUDOKU_SOLVER_STATS
+const bool SOLVER_STATS_ENABLED = true;
+#define SOLVER_STAT(...) __VA_ARGS__
+#else
+const bool SOLVER_STATS_ENABLED = false;
+#define SOLVER_STAT(...) ((void)0)
+#endif
+
+// Milliseconds since start, then restarts start at now. Times consecutive phases.
+inline double lapMilliseconds(std::chrono::steady_clock::time_point& start) {
+    auto now = std::chrono::steady_clock::now();
+    double ms = std::chrono::duration<double, std::milli>(now - start).count();
+    start = now;
+    return ms;
+}
+
+#endif // SOLVERSTATS_H
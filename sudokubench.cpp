@@ -0,0 +1,240 @@
+// Google Benchmark suite for the SudokuLogic hot paths, run over the fixed corpus
+// of benchcorpus.h so results can be compared between builds.
+//
+// Usage: SudokuBench [--benchmark_filter=regex] [--benchmark_out=file.json --benchmark_out_format=json]
+//   Times are ns per operation. allocs_per_iter and max_bytes_used come from the
+//   allocation counter below, the /s counters are per second of CPU time.
+//   The reference backtracker is only run on the generated classes, the
+//   17-clue and hardest-known puzzles take it minutes each.
+
+#include "sudokulogic.h"
+#include "benchcorpus.h"
+#include "hintengine.h"
+
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// --- Allocation counting ---
+
+namespace {
+
+std::atomic<long long> allocationCount(0);
+std::atomic<long long> bytesInUse(0);
+std::atomic<long long> peakBytes(0);
+
+// Sizes are stored in front of each block so delete can account for them
+const size_t HEADER_BYTES = alignof(std::max_align_t);
+
+void* countedAlloc(size_t size) {
+    void* block = std::malloc(size + HEADER_BYTES);
+    if (!block) throw std::bad_alloc();
+    *static_cast<size_t*>(block) = size;
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    long long inUse = bytesInUse.fetch_add(static_cast<long long>(size), std::memory_order_relaxed) + static_cast<long long>(size);
+    long long peak = peakBytes.load(std::memory_order_relaxed);
+    while (inUse > peak && !peakBytes.compare_exchange_weak(peak, inUse, std::memory_order_relaxed)) {}
+    return static_cast<char*>(block) + HEADER_BYTES;
+}
+
+void countedFree(void* pointer) {
+    if (!pointer) return;
+    void* block = static_cast<char*>(pointer) - HEADER_BYTES;
+    bytesInUse.fetch_sub(static_cast<long long>(*static_cast<size_t*>(block)), std::memory_order_relaxed);
+    std::free(block);
+}
+
+class AllocationCounter : public benchmark::MemoryManager {
+public:
+    void Start() override {
+        startCount = allocationCount.load();
+        peakBytes.store(bytesInUse.load());
+        startBytes = bytesInUse.load();
+    }
+
+    // Google Benchmark 1.8 passes a reference, older releases a pointer
+    void Stop(Result& result) {
+        result.num_allocs = allocationCount.load() - startCount;
+        result.max_bytes_used = peakBytes.load() - startBytes;
+    }
+    void Stop(Result* result) { Stop(*result); }
+
+private:
+    long long startCount = 0;
+    long long startBytes = 0;
+};
+
+} // namespace
+
+void* operator new(size_t size) { return countedAlloc(size); }
+void* operator new[](size_t size) { return countedAlloc(size); }
+void operator delete(void* pointer) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer) noexcept { countedFree(pointer); }
+void operator delete(void* pointer, size_t) noexcept { countedFree(pointer); }
+void operator delete[](void* pointer, size_t) noexcept { countedFree(pointer); }
+
+// --- Corpus ---
+
+namespace {
+
+const int GENERATED_PER_CLASS = 20;
+
+const PuzzleClass& corpusClass(int index) {
+    static const std::vector<PuzzleClass> classes = [] {
+        SudokuLogic logic;
+        std::vector<PuzzleClass> all;
+        all.push_back(generatedClass(logic, "easy", 1, GENERATED_PER_CLASS));
+        all.push_back(generatedClass(logic, "medium", 2, GENERATED_PER_CLASS));
+        all.push_back(generatedClass(logic, "hard", 3, GENERATED_PER_CLASS));
+        all.push_back(seventeenClueClass());
+        all.push_back(hardestKnownClass());
+        return all;
+    }();
+    return classes[index];
+}
+
+const int GENERATED_CLASSES = 3;
+const int ALL_CLASSES = 5;
+
+void setSolutionsRate(benchmark::State& state, long long solved) {
+    state.counters["solutions/s"] = benchmark::Counter(static_cast<double>(solved), benchmark::Counter::kIsRate);
+}
+
+} // namespace
+
+// --- Benchmarks ---
+
+static void BM_GenerateFullBoard(benchmark::State& state) {
+    SudokuLogic logic;
+    logic.seed(BENCH_CORPUS_SEED);
+    int board[SIZE][SIZE];
+    for (auto _ : state) {
+        std::fill(&board[0][0], &board[0][0] + SIZE * SIZE, 0);
+        benchmark::DoNotOptimize(logic.generateFullBoard(board));
+        benchmark::ClobberMemory();
+    }
+    state.counters["boards/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_GenerateFullBoard);
+
+// Arg: corpus class. Each iteration solves the next puzzle of the class.
+static void BM_SolveSudoku(benchmark::State& state) {
+    const PuzzleClass& pc = corpusClass(static_cast<int>(state.range(0)));
+    state.SetLabel(pc.name);
+    SudokuLogic logic;
+    size_t next = 0;
+    long long solved = 0;
+    for (auto _ : state) {
+        BenchPuzzle copy = pc.puzzles[next];
+        next = (next + 1) % pc.puzzles.size();
+        int solutionCount = 0;
+        logic.solveSudoku(copy.cells, 0, 0, solutionCount);
+        solved += solutionCount == 1;
+    }
+    setSolutionsRate(state, solved);
+}
+BENCHMARK(BM_SolveSudoku)->DenseRange(0, GENERATED_CLASSES - 1);
+
+// Args: corpus class, solver backend
+static void BM_HasUniqueSolution(benchmark::State& state) {
+    const PuzzleClass& pc = corpusClass(static_cast<int>(state.range(0)));
+    SolverBackend backend = static_cast<SolverBackend>(state.range(1));
+    const char* backendNames[] = { "backtracking", "candidates", "dancing-links" };
+    state.SetLabel(pc.name + "/" + backendNames[state.range(1)]);
+
+    SudokuLogic logic;
+    logic.setSolverBackend(backend);
+    int solution[SIZE][SIZE];
+    size_t next = 0;
+    long long solved = 0;
+    for (auto _ : state) {
+        BenchPuzzle copy = pc.puzzles[next];
+        next = (next + 1) % pc.puzzles.size();
+        solved += logic.hasUniqueSolution(copy.cells, solution);
+    }
+    setSolutionsRate(state, solved);
+}
+BENCHMARK(BM_HasUniqueSolution)
+    ->ArgsProduct({ benchmark::CreateDenseRange(0, ALL_CLASSES - 1, 1),
+                    { static_cast<int>(SolverBackend::Candidates), static_cast<int>(SolverBackend::DancingLinks) } })
+    ->ArgsProduct({ benchmark::CreateDenseRange(0, GENERATED_CLASSES - 1, 1), { static_cast<int>(SolverBackend::Backtracking) } });
+
+// Args: difficulty, dig threads. Digs the solutions of the generated corpus.
+static void BM_RemoveNumbers(benchmark::State& state) {
+    int difficulty = static_cast<int>(state.range(0));
+    SudokuLogic logic;
+    logic.setDigThreads(static_cast<int>(state.range(1)));
+    logic.seed(BENCH_CORPUS_SEED);
+
+    std::vector<BenchPuzzle> solutions;
+    for (const BenchPuzzle& p : corpusClass(difficulty - 1).puzzles) {
+        BenchPuzzle puzzle = p;
+        BenchPuzzle solved;
+        logic.countSolutions(puzzle.cells, 1, solved.cells);
+        solutions.push_back(solved);
+    }
+
+    size_t next = 0;
+    for (auto _ : state) {
+        BenchPuzzle board = solutions[next];
+        next = (next + 1) % solutions.size();
+        logic.removeNumbers(board.cells, difficulty);
+        benchmark::DoNotOptimize(board);
+    }
+    state.counters["puzzles/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_RemoveNumbers)->ArgsProduct({ { 1, 2, 3 }, { 1, 4 } })->UseRealTime(); // wall time, the dig threads work off the main thread
+
+// Arg: corpus class. What the Hint button does on a freshly loaded puzzle.
+static void BM_NextHint(benchmark::State& state) {
+    const PuzzleClass& pc = corpusClass(static_cast<int>(state.range(0)));
+    state.SetLabel(pc.name);
+    SudokuLogic logic;
+    std::vector<BoardModel> boards;
+    for (const BenchPuzzle& p : pc.puzzles) {
+        BenchPuzzle puzzle = p;
+        BenchPuzzle solved;
+        logic.countSolutions(puzzle.cells, 1, solved.cells);
+        boards.emplace_back();
+        boards.back().load(p.cells, solved.cells);
+    }
+
+    HintEngine engine;
+    size_t next = 0;
+    for (auto _ : state) {
+        Hint hint = engine.next(boards[next]);
+        next = (next + 1) % boards.size();
+        benchmark::DoNotOptimize(hint);
+    }
+    state.counters["hints/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_NextHint)->DenseRange(0, GENERATED_CLASSES - 1);
+
+// Arg: difficulty. Full generation including grading and retries.
+static void BM_GeneratePuzzle(benchmark::State& state) {
+    int difficulty = static_cast<int>(state.range(0));
+    SudokuLogic logic;
+    int board[SIZE][SIZE];
+    int solution[SIZE][SIZE];
+    uint64_t seed = BENCH_CORPUS_SEED;
+    for (auto _ : state) {
+        logic.generatePuzzle(seed++, difficulty, board, solution);
+        benchmark::DoNotOptimize(board);
+    }
+    state.counters["puzzles/s"] = benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_GeneratePuzzle)->DenseRange(1, 3);
+
+int main(int argc, char** argv) {
+    benchmark::Initialize(&argc, argv);
+    if (benchmark::ReportUnrecognizedArguments(argc, argv)) return 1;
+
+    AllocationCounter allocations;
+    benchmark::RegisterMemoryManager(&allocations);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::RegisterMemoryManager(nullptr);
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,167 @@
+#include "sudokuengine.h"
+
+#include <algorithm>
+
+namespace {
+
+// A removal that is safe is usually proven within a few nodes, while finding the
+// alternative solution of an unsafe one walks the whole board. Past this budget
+// the given is kept, which holds a 25x25 puzzle to a fraction of a second.
+const long long DIG_SEARCH_NODES = 256;
+
+} // namespace
+
+template <int BoxSize>
+void SudokuEngine<BoxSize>::generatePuzzle(uint64_t seedValue, int difficulty, int board[N][N], int solution[N][N]) {
+    seed(seedValue);
+    generateFullBoard(solution);
+    std::copy(&solution[0][0], &solution[0][0] + CELLS, &board[0][0]);
+    removeNumbers(board, cellsToRemove(difficulty));
+}
+
+template <int BoxSize>
+void SudokuEngine<BoxSize>::generateFullBoard(int board[N][N]) {
+    const int box = Size::BOX;
+    for (int attempt = 0; attempt < FILL_ATTEMPTS; ++attempt) {
+        BasicCandidateSolver<BoxSize> solver;
+
+        // The diagonal boxes share no unit, any digit order is valid in each
+        for (int b = 0; b < box; ++b) {
+            int digits[N];
+            for (int i = 0; i < N; ++i) digits[i] = i + 1;
+            rng.shuffle(digits, digits + N);
+            for (int i = 0; i < N; ++i) solver.place(b * box + i / box, b * box + i % box, digits[i]);
+        }
+
+        long long nodesLeft = FILL_NODES;
+        if (fillRandom(solver, nodesLeft)) {
+            for (int cell = 0; cell < CELLS; ++cell) board[cell / N][cell % N] = solver.valueAt(cell / N, cell % N);
+            return;
+        }
+    }
+    fillFromPattern(board);
+}
+
+template <int BoxSize>
+bool SudokuEngine<BoxSize>::fillRandom(BasicCandidateSolver<BoxSize>& solver, long long& nodesLeft) {
+    if (nodesLeft-- <= 0) return false;
+
+    int best = -1;
+    unsigned int bestMask = 0;
+    int bestCount = N + 1;
+    for (int cell = 0; cell < CELLS && bestCount > 1; ++cell) {
+        if (solver.valueAt(cell / N, cell % N) != 0) continue;
+        unsigned int mask = solver.candidates(cell / N, cell % N);
+        int count = popCount(mask);
+        if (count == 0) return false;
+        if (count < bestCount) {
+            best = cell;
+            bestMask = mask;
+            bestCount = count;
+        }
+    }
+    if (best < 0) return true; // board full
+
+    int digits[N];
+    int count = 0;
+    for (unsigned int rest = bestMask; rest; rest &= rest - 1) digits[count++] = lowestBit(rest) + 1;
+    rng.shuffle(digits, digits + count);
+    for (int i = 0; i < count; ++i) {
+        solver.place(best / N, best % N, digits[i]);
+        if (fillRandom(solver, nodesLeft)) return true;
+        solver.unplace(best / N, best % N);
+    }
+    return false;
+}
+
+template <int BoxSize>
+void SudokuEngine<BoxSize>::fillFromPattern(int board[N][N]) {
+    const int box = Size::BOX;
+
+    // digits[d] replaces digit d + 1, rows[r] and cols[c] are the pattern lines shown at r and c
+    int digits[N], rows[N], cols[N];
+    for (int i = 0; i < N; ++i) digits[i] = i + 1;
+    rng.shuffle(digits, digits + N);
+
+    int bands[box], stacks[box];
+    for (int i = 0; i < box; ++i) bands[i] = stacks[i] = i;
+    rng.shuffle(bands, bands + box);
+    rng.shuffle(stacks, stacks + box);
+    for (int band = 0; band < box; ++band) {
+        int* rowsOfBand = rows + band * box;
+        int* colsOfStack = cols + band * box;
+        for (int i = 0; i < box; ++i) {
+            rowsOfBand[i] = bands[band] * box + i;
+            colsOfStack[i] = stacks[band] * box + i;
+        }
+        rng.shuffle(rowsOfBand, rowsOfBand + box);
+        rng.shuffle(colsOfStack, colsOfStack + box);
+    }
+
+    // Row r of the pattern is row 0 shifted by box * (r % box) + r / box, which keeps every unit complete
+    for (int row = 0; row < N; ++row) {
+        int r = rows[row];
+        for (int col = 0; col < N; ++col) {
+            board[row][col] = digits[(box * (r % box) + r / box + cols[col]) % N];
+        }
+    }
+
+    if (rng.below(2)) {
+        for (int row = 0; row < N; ++row) {
+            for (int col = row + 1; col < N; ++col) std::swap(board[row][col], board[col][row]);
+        }
+    }
+}
+
+template <int BoxSize>
+int SudokuEngine<BoxSize>::removeNumbers(int board[N][N], int count) {
+    typename Size::CellIndex order[CELLS];
+    for (int i = 0; i < CELLS; ++i) order[i] = static_cast<typename Size::CellIndex>(i);
+    rng.shuffle(order, order + CELLS);
+
+    BasicCandidateSolver<BoxSize> solver;
+    solver.load(board);
+    solver.setSearchBudget(DIG_SEARCH_NODES);
+
+    int removedCount = 0;
+    for (int i = 0; i < CELLS && removedCount < count; ++i) {
+        int row = order[i] / N;
+        int col = order[i] % N;
+        int value = board[row][col];
+        if (value == 0) continue;
+
+        // The removal is safe if no other digit fits here
+        solver.unplace(row, col);
+        if (solver.hasAlternative(row, col, value)) {
+            solver.place(row, col, value);
+        }
+        else {
+            board[row][col] = 0;
+            removedCount++;
+        }
+    }
+    return removedCount;
+}
+
+template <int BoxSize>
+int SudokuEngine<BoxSize>::countSolutions(const int board[N][N], int limit, int solution[N][N]) {
+    BasicCandidateSolver<BoxSize> solver;
+    if (!solver.load(board)) return 0;
+    return solver.countSolutions(limit, solution);
+}
+
+// Same share of the board as the 9x9 game's 35 / 55 / 60 removals. Expert tries
+// every cell, which digs as far as the search budget can prove removals safe.
+template <int BoxSize>
+int SudokuEngine<BoxSize>::cellsToRemove(int difficulty) {
+    switch (difficulty) {
+    case 1: return CELLS * 35 / 81; // Easy
+    case 3: return CELLS * 60 / 81; // Hard
+    case 4: return CELLS;           // Expert
+    default: return CELLS * 55 / 81; // Medium
+    }
+}
+
+template class SudokuEngine<2>;
+template class SudokuEngine<4>;
+template class SudokuEngine<5>;
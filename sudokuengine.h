@@ -0,0 +1,56 @@
+#pragma once
+#ifndef SUDOKUENGINE_H
+#define SUDOKUENGINE_H
+
+#include <cstdint>
+
+#include "boardsize.h"
+#include "candidatesolver.h"
+#include "xoshiro.h"
+
+// Generator and solver for the other board sizes, picked at compile time by the box
+// size: SudokuEngine<2> is 4x4, <4> 16x16 and <5> 25x25. Masks and index types come
+// from BoardSize, so the code is the same at every size. 9x9 puzzles come from
+// SudokuLogic, which adds grading and the other solver backends. Instantiated for
+// box sizes 2, 4 and 5 in sudokuengine.cpp.
+template <int BoxSize>
+class SudokuEngine {
+public:
+    using Size = BoardSize<BoxSize>;
+    static const int N = Size::N;
+    static const int CELLS = Size::CELLS;
+
+    // Fills solution and digs board, the same seed always gives the same puzzle.
+    // difficulty 1-4 sets how many givens are removed, see cellsToRemove.
+    void generatePuzzle(uint64_t seed, int difficulty, int board[N][N], int solution[N][N]);
+
+    // Random complete board: the boxes on the diagonal get random digits, the rest is
+    // filled by a depth-first search that takes the cell with the fewest candidates
+    // and tries its digits in random order. A fill that runs past FILL_NODES starts
+    // over, since a bad early choice on 25x25 can stall for seconds. After
+    // FILL_ATTEMPTS such restarts the board comes from fillFromPattern.
+    void generateFullBoard(int board[N][N]);
+
+    // Removes up to count givens in random order, keeping the solution unique.
+    // Returns the number removed.
+    int removeNumbers(int board[N][N], int count);
+
+    int countSolutions(const int board[N][N], int limit, int solution[N][N] = nullptr);
+
+    static int cellsToRemove(int difficulty);
+
+    void seed(uint64_t value) { rng.seed(value); }
+
+private:
+    static const int FILL_ATTEMPTS = 8;
+    static const long long FILL_NODES = 4LL * CELLS;
+
+    bool fillRandom(BasicCandidateSolver<BoxSize>& solver, long long& nodesLeft);
+    // A valid pattern grid with its digits, rows within bands, bands, columns within
+    // stacks and stacks shuffled, then transposed half the time. Linear time.
+    void fillFromPattern(int board[N][N]);
+
+    Xoshiro256 rng;
+};
+
+#endif // SUDOKUENGINE_H
@@ -0,0 +1,284 @@
+// Headless batch puzzle generator, used to build puzzle banks offline.
+//
+// Usage: SudokuGen [-n count] [-d difficulty] [-b box-size] [-s seed] [-t threads] [-j dig-threads]
+//                  [-y symmetry] [-p pattern-file] [-f text|binary] [-o file] [--stats]
+//   -n  number of puzzles (default 1000)
+//   -d  1 = Easy, 2 = Medium, 3 = Hard, 4 = Expert, minimal puzzles of 20-22 givens (default 2)
+//   -b  2 = 4x4, 3 = 9x9, 4 = 16x16, 5 = 25x25 (default 3). Only 9x9 puzzles are
+//       graded, other sizes use SudokuEngine and text output with digits 1-9, A-P.
+//   -s  seed of the first puzzle, puzzle i uses seed + i (default random).
+//       Output is identical for any -t and -j, and "-n 1 -s <seed>" regenerates
+//       the puzzle of a saved game.
+//   -t  worker threads, 0 = all cores (default 0)
+//   -j  threads checking removals of one puzzle in parallel (default 1)
+//   -y  none, rotational (180 degrees), mirror (left-right) or diagonal (default none)
+//   -p  file with 81 characters, '.' or '0' for cells that must stay empty and any
+//       other character for cells that may keep a given. Whitespace is skipped.
+//       A puzzle the pattern does not fit is written as an empty board.
+//       -y and -p are 9x9 only.
+//   -f  text: one 81-character line per puzzle, '.' for empty cells
+//       binary: 41-byte nibble-packed records (see boardpacking.h)
+//   -o  output file (default stdout)
+//   --stats  also report solver statistics per 9x9 puzzle, needs a build with
+//            SUDOKU_SOLVER_STATS
+// Throughput is reported on stderr.
+
+#include "sudokulogic.h"
+#include "sudokuengine.h"
+#include "boardpacking.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+namespace {
+
+// Puzzles a worker generates before taking the output lock
+const int BATCH_SIZE = 64;
+
+struct Options {
+    long long count = 1000;
+    int difficulty = 2;
+    int boxSize = 3;
+    uint64_t seed = 0;
+    bool seeded = false;
+    int threads = 0;
+    int digThreads = 1;
+    bool binary = false;
+    const char* outputPath = nullptr;
+    bool stats = false;
+    Symmetry symmetry = Symmetry::None;
+    const char* patternPath = nullptr;
+    bool pattern[SIZE][SIZE];
+};
+
+void printUsage() {
+    std::fprintf(stderr, "Usage: SudokuGen [-n count] [-d 1|2|3|4] [-b 2|3|4|5] [-s seed] [-t threads] [-j dig-threads]\n"
+                         "                 [-y none|rotational|mirror|diagonal] [-p pattern-file] [-f text|binary] [-o file] [--stats]\n");
+}
+
+bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        if (std::strcmp(arg, "--stats") == 0) {
+            options.stats = true;
+            continue;
+        }
+        const char* value = (i + 1 < argc) ? argv[i + 1] : nullptr;
+        if (!value) return false;
+
+        if (std::strcmp(arg, "-n") == 0) options.count = std::atoll(value);
+        else if (std::strcmp(arg, "-d") == 0) options.difficulty = std::atoi(value);
+        else if (std::strcmp(arg, "-b") == 0) options.boxSize = std::atoi(value);
+        else if (std::strcmp(arg, "-s") == 0) {
+            options.seed = std::strtoull(value, nullptr, 0);
+            options.seeded = true;
+        }
+        else if (std::strcmp(arg, "-t") == 0) options.threads = std::atoi(value);
+        else if (std::strcmp(arg, "-j") == 0) options.digThreads = std::atoi(value);
+        else if (std::strcmp(arg, "-f") == 0) {
+            if (std::strcmp(value, "binary") == 0) options.binary = true;
+            else if (std::strcmp(value, "text") == 0) options.binary = false;
+            else return false;
+        }
+        else if (std::strcmp(arg, "-y") == 0) {
+            if (std::strcmp(value, "none") == 0) options.symmetry = Symmetry::None;
+            else if (std::strcmp(value, "rotational") == 0) options.symmetry = Symmetry::Rotational;
+            else if (std::strcmp(value, "mirror") == 0) options.symmetry = Symmetry::Mirror;
+            else if (std::strcmp(value, "diagonal") == 0) options.symmetry = Symmetry::Diagonal;
+            else return false;
+        }
+        else if (std::strcmp(arg, "-p") == 0) options.patternPath = value;
+        else if (std::strcmp(arg, "-o") == 0) options.outputPath = value;
+        else return false;
+        ++i;
+    }
+    if (options.boxSize < 2 || options.boxSize > 5) return false;
+    if (options.boxSize != 3 && (options.binary || options.symmetry != Symmetry::None || options.patternPath)) return false;
+    return options.count > 0 && options.difficulty >= 1 && options.difficulty <= 4 && options.threads >= 0 && options.digThreads >= 1;
+}
+
+// Shared output, batches are written strictly in index order
+struct Output {
+    std::FILE* file = nullptr;
+    std::mutex mutex;
+    std::condition_variable turn;
+    long long nextToWrite = 0;
+    SolverStats stats; // summed over all puzzles when they are collected
+    std::atomic<long long> misfits{ 0 }; // puzzles the clue pattern did not fit
+};
+
+// Reads the clue pattern of -p, false if the file is missing or too short
+bool loadPattern(const char* path, bool pattern[SIZE][SIZE]) {
+    std::FILE* file = std::fopen(path, "r");
+    if (!file) return false;
+    int cell = 0;
+    int ch;
+    while (cell < SIZE * SIZE && (ch = std::fgetc(file)) != EOF) {
+        if (ch == ' ' || ch == '\t' || ch == '\r' || ch == '\n') continue;
+        pattern[cell / SIZE][cell % SIZE] = (ch != '.' && ch != '0');
+        cell++;
+    }
+    std::fclose(file);
+    return cell == SIZE * SIZE;
+}
+
+// Appends one batch of puzzles to buffer
+void generateClassic(const Options& options, SudokuLogic& logic, long long start, long long batch, std::vector<char>& buffer, SolverStats& stats, Output& output) {
+    for (long long i = 0; i < batch; ++i) {
+        int board[SIZE][SIZE];
+        int solution[SIZE][SIZE];
+        uint64_t seed = options.seeded ? options.seed + static_cast<uint64_t>(start + i) : logic.newSeed();
+        if (!logic.generatePuzzle(seed, options.difficulty, board, solution)) {
+            std::fill(&board[0][0], &board[0][0] + SIZE * SIZE, 0);
+            output.misfits++;
+        }
+        stats.add(logic.stats());
+
+        if (options.binary) {
+            uint8_t packed[PACKED_BOARD_BYTES];
+            packBoard(board, packed);
+            buffer.insert(buffer.end(), packed, packed + PACKED_BOARD_BYTES);
+        }
+        else {
+            char line[82];
+            boardToLine(board, line);
+            line[81] = '\n';
+            buffer.insert(buffer.end(), line, line + 82);
+        }
+    }
+}
+
+template <int BoxSize>
+void generateSized(const Options& options, SudokuLogic& logic, long long start, long long batch, std::vector<char>& buffer) {
+    const int n = SudokuEngine<BoxSize>::N;
+    const char digits[] = ".123456789ABCDEFGHIJKLMNOP";
+    SudokuEngine<BoxSize> engine;
+
+    for (long long i = 0; i < batch; ++i) {
+        int board[n][n];
+        int solution[n][n];
+        uint64_t seed = options.seeded ? options.seed + static_cast<uint64_t>(start + i) : logic.newSeed();
+        engine.generatePuzzle(seed, options.difficulty, board, solution);
+
+        for (int cell = 0; cell < n * n; ++cell) buffer.push_back(digits[board[cell / n][cell % n]]);
+        buffer.push_back('\n');
+    }
+}
+
+void generateWorker(const Options& options, std::atomic<long long>& nextIndex, Output& output) {
+    SudokuLogic logic;
+    logic.setDigThreads(options.digThreads);
+    logic.setSymmetry(options.symmetry);
+    if (options.patternPath) logic.setCluePattern(options.pattern);
+    std::vector<char> buffer;
+    SolverStats stats;
+
+    while (true) {
+        long long start = nextIndex.fetch_add(BATCH_SIZE);
+        if (start >= options.count) break;
+        long long batch = std::min<long long>(BATCH_SIZE, options.count - start);
+
+        buffer.clear();
+        switch (options.boxSize) {
+        case 2: generateSized<2>(options, logic, start, batch, buffer); break;
+        case 4: generateSized<4>(options, logic, start, batch, buffer); break;
+        case 5: generateSized<5>(options, logic, start, batch, buffer); break;
+        default: generateClassic(options, logic, start, batch, buffer, stats, output); break;
+        }
+
+        // Batches are claimed in order, so the one being waited for is always in progress
+        std::unique_lock<std::mutex> lock(output.mutex);
+        output.turn.wait(lock, [&] { return output.nextToWrite == start; });
+        std::fwrite(buffer.data(), 1, buffer.size(), output.file);
+        output.nextToWrite += batch;
+        output.turn.notify_all();
+    }
+
+    std::lock_guard<std::mutex> lock(output.mutex);
+    output.stats.add(stats);
+}
+
+void printStats(const Options& options, const SolverStats& stats) {
+    if (!SOLVER_STATS_ENABLED) {
+        std::fprintf(stderr, "Solver statistics are not compiled in, rebuild with SUDOKU_SOLVER_STATS\n");
+        return;
+    }
+    if (options.boxSize != 3) {
+        std::fprintf(stderr, "Solver statistics are only collected for 9x9 puzzles\n");
+        return;
+    }
+    // maxDepth is the deepest of any puzzle, everything else the average per puzzle
+    double n = static_cast<double>(options.count);
+    std::fprintf(stderr, "Per puzzle: %.1f attempts, %.0f nodes, %.0f backtracks, %.1f uniqueness checks, max depth %d\n",
+        stats.attempts / n, stats.nodes / n, stats.backtracks / n, stats.uniquenessChecks / n, stats.maxDepth);
+    std::fprintf(stderr, "Per puzzle: fill %.3f ms, dig %.3f ms, grade %.3f ms\n",
+        stats.fillMs / n, stats.digMs / n, stats.gradeMs / n);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (options.patternPath && !loadPattern(options.patternPath, options.pattern)) {
+        std::fprintf(stderr, "Could not read an 81-cell clue pattern from %s\n", options.patternPath);
+        return 1;
+    }
+
+    int threadCount = options.threads;
+    if (threadCount == 0) threadCount = std::max(1u, std::thread::hardware_concurrency());
+
+    std::FILE* out = stdout;
+    if (options.outputPath) {
+        out = std::fopen(options.outputPath, options.binary ? "wb" : "w");
+        if (!out) {
+            std::fprintf(stderr, "Could not open %s for writing\n", options.outputPath);
+            return 1;
+        }
+    }
+#ifdef _WIN32
+    else if (options.binary) {
+        _setmode(_fileno(stdout), _O_BINARY);
+    }
+#endif
+
+    std::atomic<long long> nextIndex(0);
+    Output output;
+    output.file = out;
+
+    auto startTime = std::chrono::steady_clock::now();
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threadCount; ++t) {
+        workers.emplace_back(generateWorker, std::cref(options), std::ref(nextIndex), std::ref(output));
+    }
+    for (std::thread& worker : workers) worker.join();
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+
+    if (out != stdout) std::fclose(out);
+    else std::fflush(stdout);
+
+    const int n = options.boxSize * options.boxSize;
+    std::fprintf(stderr, "Generated %lld %dx%d puzzles (difficulty %d) in %.3f s on %d threads: %.0f puzzles/s\n",
+        options.count, n, n, options.difficulty, seconds, threadCount, options.count / seconds);
+    if (options.stats) printStats(options, output.stats);
+    if (output.misfits > 0) {
+        std::fprintf(stderr, "The clue pattern gave no unique puzzle for %lld of them, written as empty boards\n", output.misfits.load());
+        return 1;
+    }
+    return 0;
+}
@@ -1,23 +1,25 @@
 #include "sudokulogic.h"
+#include "candidatesolver.h"
+#include "boardtables.h"
+#include "simdboard.h"
+#include "minimaldigger.h"
+
+#include <random>
+#include <thread>
 
 SudokuLogic::SudokuLogic() {
-    // Constructor
+    // Seed once, random_device can be a system call on every use
+    std::random_device device;
+    uint64_t entropy = (static_cast<uint64_t>(device()) << 32) | device();
+    seedSource.seed(entropy);
+    rng.seed(newSeed());
 }
 
 bool SudokuLogic::isValid(int board[SIZE][SIZE], int row, int col, int num) {
-    // Check row and column
-    for (int i = 0; i < SIZE; i++) {
-        if (board[row][i] == num && i != col) return false;
-        if (board[i][col] == num && i != row) return false;
-    }
-
-    // Check 3x3 box
-    int startRow = (row / 3) * 3, startCol = (col / 3) * 3;
-    for (int i = startRow; i < startRow + 3; i++) {
-        for (int j = startCol; j < startCol + 3; j++) {
-            if (i == row && j == col) continue;
-            if (board[i][j] == num) return false;
-        }
+    // Check the row, column and box in one pass over the peers
+    const int* cells = &board[0][0];
+    for (uint8_t peer : CLASSIC_TABLES.peers[row * SIZE + col]) {
+        if (cells[peer] == num) return false;
     }
     return true;
 }
@@ -34,9 +36,7 @@ bool SudokuLogic::generateFullBoard(int board[SIZE][SIZE], int row, int col) {
     if (board[row][col] != 0) return generateFullBoard(board, nextRow, nextCol);
 
     std::vector<int> numbers = { 1, 2, 3, 4, 5, 6, 7, 8, 9 };
-    std::random_device rd;
-    std::mt19937 g(rd());
-    std::shuffle(numbers.begin(), numbers.end(), g);
+    rng.shuffle(numbers.begin(), numbers.end());
 
     for (int num : numbers) {
         if (isValid(board, row, col, num)) {
@@ -50,7 +50,8 @@ bool SudokuLogic::generateFullBoard(int board[SIZE][SIZE], int row, int col) {
     return false;
 }
 
-bool SudokuLogic::solveSudoku(int currentBoard[SIZE][SIZE], int row, int col, int& solutionCount) {
+bool SudokuLogic::solveSudoku(int currentBoard[SIZE][SIZE], int row, int col, int& solutionCount, int limit, int solution[SIZE][SIZE]) {
+    SOLVER_STAT(solverStats.nodes++);
     while (row < SIZE && currentBoard[row][col] != 0) {
         col++;
         if (col == SIZE) {
@@ -62,40 +63,23 @@ bool SudokuLogic::solveSudoku(int currentBoard[SIZE][SIZE], int row, int col, in
     // no empty cell, a solution is reached
     if (row == SIZE) {
         solutionCount++;
-        return solutionCount <= 1;
+        if (solutionCount == 1 && solution) std::copy(&currentBoard[0][0], &currentBoard[0][0] + SIZE * SIZE, &solution[0][0]);
+        return solutionCount < limit;
     }
 
+    SOLVER_STAT(bool anyFits = false);
     for (int num = 1; num <= SIZE; num++) {
-        int tempBoardCheck[SIZE][SIZE];
-        std::copy(&currentBoard[0][0], &currentBoard[0][0] + SIZE * SIZE, &tempBoardCheck[0][0]);
-        tempBoardCheck[row][col] = num;
-
-        bool placement_valid = true;
-        // Check row
-        for (int k = 0; k < SIZE; ++k) if (k != col && tempBoardCheck[row][k] == num) placement_valid = false;
-        // Check col
-        if (placement_valid) for (int k = 0; k < SIZE; ++k) if (k != row && tempBoardCheck[k][col] == num) placement_valid = false;
-        // Check box
-        if (placement_valid) {
-            int startRow = (row / 3) * 3;
-            int startCol = (col / 3) * 3;
-            for (int i = startRow; i < startRow + 3; ++i) {
-                for (int j = startCol; j < startCol + 3; ++j) {
-                    if ((i != row || j != col) && tempBoardCheck[i][j] == num) placement_valid = false;
-                }
-            }
-        }
-
-        if (placement_valid) {
+        if (isValid(currentBoard, row, col, num)) {
+            SOLVER_STAT(anyFits = true);
             currentBoard[row][col] = num;
 
-            if (!solveSudoku(currentBoard, row, col, solutionCount)) {
-                // false (> 1 solution), stop
+            if (!solveSudoku(currentBoard, row, col, solutionCount, limit, solution)) {
+                // false (limit reached), stop
                 currentBoard[row][col] = 0; // Backtrack
                 return false;
             }
             // stop early
-            if (solutionCount > 1) {
+            if (solutionCount >= limit) {
                 currentBoard[row][col] = 0; // Backtrack
                 return false;
             }
@@ -103,22 +87,53 @@ bool SudokuLogic::solveSudoku(int currentBoard[SIZE][SIZE], int row, int col, in
     }
 
     currentBoard[row][col] = 0; // backtrack
-    
-    return solutionCount <= 1;
+    SOLVER_STAT(if (!anyFits) solverStats.backtracks++); // dead end
+
+    return solutionCount < limit;
 }
 
-void SudokuLogic::removeNumbers(int currentBoard[SIZE][SIZE], int difficulty) {
+bool SudokuLogic::removeNumbers(int currentBoard[SIZE][SIZE], int difficulty) {
+    int fullBoard[SIZE][SIZE];
+    std::copy(&currentBoard[0][0], &currentBoard[0][0] + SIZE * SIZE, &fullBoard[0][0]);
+
+    // Cells outside the clue pattern go first, all at once
+    int removedCount = 0;
+    if (hasCluePattern) {
+        for (int r = 0; r < SIZE; ++r) {
+            for (int c = 0; c < SIZE; ++c) {
+                if (cluePattern[r][c] || currentBoard[r][c] == 0) continue;
+                currentBoard[r][c] = 0;
+                removedCount++;
+            }
+        }
+        SOLVER_STAT(solverStats.uniquenessChecks++);
+        if (countSolutions(currentBoard, 2) != 1) {
+            std::copy(&fullBoard[0][0], &fullBoard[0][0] + SIZE * SIZE, &currentBoard[0][0]);
+            return false;
+        }
+    }
+
+    if (difficulty == 4) {
+        // Expert: as many as possible. Sequential and on the candidate engine for any
+        // backend setting, the witness store needs the solutions it finds.
+        MinimalDigger digger(rng);
+        digger.setSymmetry(symmetry);
+        digger.setStats(&solverStats);
+        [[maybe_unused]] int givens = digger.dig(currentBoard, fullBoard); // only logged
+        ENGINE_LOG("Dug a minimal puzzle with %d givens", givens);
+        return true;
+    }
+
     int cellsToRemove;
     switch (difficulty) {
+    // Only an upper bound, generatePuzzle grades what is left. Medium and Hard need
+    // deep digs, few puzzles with 45 or fewer holes need more than singles.
     case 1: cellsToRemove = 35; break; // Easy
-    case 2: cellsToRemove = 45; break; // Medium
-    case 3: cellsToRemove = 55; break; // Hard
+    case 2: cellsToRemove = 55; break; // Medium
+    case 3: cellsToRemove = 60; break; // Hard
     default: cellsToRemove = 45; break;
     }
 
-    std::random_device rd;
-    std::mt19937 g(rd());
-    int removedCount = 0;
     int attempts = 0;
 
     std::vector<std::pair<int, int>> cellsList;
@@ -127,7 +142,24 @@ void SudokuLogic::removeNumbers(int currentBoard[SIZE][SIZE], int difficulty) {
             cellsList.push_back({ r, c });
         }
     }
-    std::shuffle(cellsList.begin(), cellsList.end(), g);
+    rng.shuffle(cellsList.begin(), cellsList.end());
+
+    // The parallel dig tries single cells, symmetric groups are dug sequentially. Easy
+    // digs are over in microseconds, handing out the trials would cost more than they take.
+    if (digThreads > 1 && difficulty > 1 && backend == SolverBackend::Candidates && symmetry == Symmetry::None) {
+        removedCount += removeNumbersParallel(currentBoard, cellsList, cellsToRemove - removedCount);
+        ENGINE_LOG("Removed %d cells for difficulty %d on %d threads", removedCount, difficulty, digThreads);
+        return true;
+    }
+
+    // The candidate engine can test a removal incrementally, other backends recount
+    bool incremental = (backend == SolverBackend::Candidates);
+    CandidateSolver solver;
+    solver.setStats(&solverStats);
+    if (incremental) solver.load(currentBoard);
+
+    // Partners of groups that had to stay, trying them again would fail the same way
+    bool kept[SIZE * SIZE] = {};
 
     for (const auto& cell : cellsList) {
         if (removedCount >= cellsToRemove) break;
@@ -135,27 +167,205 @@ void SudokuLogic::removeNumbers(int currentBoard[SIZE][SIZE], int difficulty) {
 
         int row = cell.first;
         int col = cell.second;
+        if (currentBoard[row][col] == 0 || kept[row * SIZE + col]) continue;
 
-        if (currentBoard[row][col] != 0) {
-            int tempVal = currentBoard[row][col];
-            currentBoard[row][col] = 0; 
-            attempts++;
+        // The cell and its symmetric partner go together, one uniqueness check for both
+        int group[2] = { row * SIZE + col, symmetricCell(symmetry, row * SIZE + col) };
+        int values[2] = { currentBoard[row][col], currentBoard[group[1] / SIZE][group[1] % SIZE] };
+        int groupSize = (group[1] != group[0] && values[1] != 0) ? 2 : 1;
 
-            // Check uniqueness
-            int tempBoard[SIZE][SIZE];
-            std::copy(&currentBoard[0][0], &currentBoard[0][0] + SIZE * SIZE, &tempBoard[0][0]);
-            int solutionCount = 0;
-            solveSudoku(tempBoard, 0, 0, solutionCount);
+        attempts++;
+        SOLVER_STAT(solverStats.uniquenessChecks++);
+        for (int i = 0; i < groupSize; ++i) {
+            currentBoard[group[i] / SIZE][group[i] % SIZE] = 0;
+            if (incremental) solver.unplace(group[i] / SIZE, group[i] % SIZE);
+        }
 
-            if (solutionCount != 1) {
-                currentBoard[row][col] = tempVal;
+        // Check uniqueness: the removal is safe if no other digit fits in the group
+        bool ambiguous = incremental ? solver.hasAlternative(group, values, groupSize) : countSolutions(currentBoard, 2) != 1;
+        if (ambiguous) {
+            for (int i = 0; i < groupSize; ++i) {
+                currentBoard[group[i] / SIZE][group[i] % SIZE] = values[i];
+                if (incremental) solver.place(group[i] / SIZE, group[i] % SIZE, values[i]);
+                kept[group[i]] = true;
             }
-            else {
-                removedCount++;
+        }
+        else {
+            removedCount += groupSize;
+        }
+    }
+    ENGINE_LOG("Removed %d cells for difficulty %d", removedCount, difficulty);
+    return true;
+}
+
+// Checks a window of upcoming cells at once, each trial removing only its own cell.
+// A cell that is ambiguous on its own stays ambiguous once more cells are gone, so a
+// failed trial is kept for good and its cell never tried again. The successful trials
+// are then removed together, in order, with one uniqueness check for all of them. If
+// that check fails, the longest prefix that stays unique is removed, the success after
+// it is kept and the rest are tried again. The result is exactly what the sequential
+// dig gives for the same order.
+int SudokuLogic::removeNumbersParallel(int currentBoard[SIZE][SIZE], const std::vector<std::pair<int, int>>& cellsList, int cellsToRemove) {
+    if (!digPool || digPool->threadCount() != digThreads) {
+        digPool = std::make_unique<WorkStealingPool>(digThreads);
+    }
+
+    CandidateSolver solver;
+    solver.load(currentBoard);
+
+    const int window = digPool->threadCount();
+    std::vector<size_t> windowCells(window); // indices into cellsList
+    std::vector<char> ambiguous(window);
+    std::vector<int> successes(window);     // indices into windowCells, in order
+    bool kept[SIZE * SIZE] = {};             // failed a trial, stays a given
+    SOLVER_STAT(std::vector<SolverStats> trialStats(window));
+    int removedCount = 0;
+    size_t next = 0;
+
+    // True if the board stays unique without the first count successes
+    auto uniqueWithout = [&](int count) {
+        CandidateSolver combined = solver;
+        combined.setStats(&solverStats);
+        for (int i = 0; i < count; ++i) {
+            const auto& cell = cellsList[windowCells[successes[i]]];
+            combined.unplace(cell.first, cell.second);
+        }
+        SOLVER_STAT(solverStats.uniquenessChecks++);
+        return combined.countSolutions(2) == 1;
+    };
+
+    while (removedCount < cellsToRemove) {
+        int batch = 0;
+        for (size_t i = next; i < cellsList.size() && batch < window; ++i) {
+            int row = cellsList[i].first, col = cellsList[i].second;
+            if (solver.valueAt(row, col) != 0 && !kept[row * SIZE + col]) windowCells[batch++] = i;
+        }
+        if (batch == 0) break;
+
+        digPool->parallelFor(batch, [&](int k) {
+            int row = cellsList[windowCells[k]].first;
+            int col = cellsList[windowCells[k]].second;
+            CandidateSolver trial = solver;
+            SOLVER_STAT(trial.setStats(&trialStats[k]));
+            trial.unplace(row, col);
+            ambiguous[k] = trial.hasAlternative(row, col, solver.valueAt(row, col)) ? 1 : 0;
+        });
+
+        SOLVER_STAT(for (int t = 0; t < batch; ++t) {
+            solverStats.uniquenessChecks++;
+            solverStats.add(trialStats[t]);
+            trialStats[t] = SolverStats();
+        });
+
+        int successCount = 0;
+        for (int k = 0; k < batch; ++k) {
+            const auto& cell = cellsList[windowCells[k]];
+            if (ambiguous[k]) kept[cell.first * SIZE + cell.second] = true;
+            else successes[successCount++] = k;
+        }
+
+        // The first success is safe on its own, a prefix that is unique keeps every shorter one unique
+        next = windowCells[batch - 1] + 1;
+        int take = std::min(successCount, cellsToRemove - removedCount);
+        if (take > 1 && !uniqueWithout(take)) {
+            int low = 1, high = take - 1;
+            while (low < high) {
+                int mid = (low + high + 1) / 2;
+                if (uniqueWithout(mid)) low = mid;
+                else high = mid - 1;
+            }
+            take = low;
+            const auto& failed = cellsList[windowCells[successes[take]]];
+            kept[failed.first * SIZE + failed.second] = true; // ambiguous once the prefix is gone
+            if (take + 1 < successCount) next = windowCells[successes[take + 1]];
+        }
+
+        for (int i = 0; i < take; ++i) {
+            const auto& cell = cellsList[windowCells[successes[i]]];
+            solver.unplace(cell.first, cell.second);
+            currentBoard[cell.first][cell.second] = 0;
+            removedCount++;
+        }
+    }
+    return removedCount;
+}
+
+bool SudokuLogic::generatePuzzle(uint64_t seedValue, int difficulty, int board[SIZE][SIZE], int solution[SIZE][SIZE], PuzzleGrade* grade) {
+    const int maxAttempts = 200;
+    const int maxPatternGrids = 20000; // grids the clue pattern may reject, each costs one solve
+    seed(seedValue);
+    resetStats();
+
+    PuzzleGrade rating;
+    int rejectedGrids = 0;
+    for (int attempt = 1; attempt <= maxAttempts; ++attempt) {
+        SOLVER_STAT(solverStats.attempts++; auto phaseStart = std::chrono::steady_clock::now());
+        std::fill(&solution[0][0], &solution[0][0] + SIZE * SIZE, 0);
+        if (!generateFullBoard(solution)) return false;
+        SOLVER_STAT(solverStats.fillMs += lapMilliseconds(phaseStart));
+
+        std::copy(&solution[0][0], &solution[0][0] + SIZE * SIZE, &board[0][0]);
+        bool patternFits = removeNumbers(board, difficulty);
+        SOLVER_STAT(solverStats.digMs += lapMilliseconds(phaseStart));
+        if (!patternFits) {
+            if (++rejectedGrids == maxPatternGrids) {
+                ENGINE_LOG("The clue pattern gave no unique puzzle in %d grids", maxPatternGrids);
+                return false;
             }
+            attempt--; // not an attempt at the band
+            continue;
         }
+
+        rating = grader.grade(board);
+        SOLVER_STAT(solverStats.gradeMs += lapMilliseconds(phaseStart));
+        if (inDifficultyBand(rating.hardest, difficulty)) break;
+        if (attempt == maxAttempts) ENGINE_LOG("No puzzle in the band of difficulty %d after %d attempts", difficulty, maxAttempts);
     }
-    qDebug() << "Removed" << removedCount << "cells for difficulty" << difficulty;
+    if (grade) *grade = rating;
+    return true;
+}
+
+// Easy: singles only. Medium: needs locked candidates or a pair/triple. Hard: needs a fish or more.
+// Expert is about the number of givens, a minimal puzzle of any grade will do.
+bool SudokuLogic::inDifficultyBand(Technique hardest, int difficulty) {
+    switch (difficulty) {
+    case 1: return hardest <= Technique::NakedSingle;
+    case 3: return hardest >= Technique::XWing;
+    case 4: return true;
+    default: return hardest >= Technique::LockedCandidates && hardest <= Technique::NakedTriple;
+    }
+}
+
+void SudokuLogic::seed(uint64_t value) {
+    rng.seed(value);
+}
+
+uint64_t SudokuLogic::newSeed() {
+    uint64_t value;
+    do {
+        value = seedSource.next();
+    } while (value == 0); // 0 marks puzzles that were not generated, see SaveData::seed
+    return value;
+}
+
+int SudokuLogic::randomIndex(int count) {
+    return count > 0 ? static_cast<int>(rng.below(static_cast<uint32_t>(count))) : 0;
+}
+
+void SudokuLogic::setDigThreads(int threads) {
+    // More dig threads than cores only adds trials that wait for a core
+    int cores = static_cast<int>(std::thread::hardware_concurrency());
+    if (cores > 0) threads = std::min(threads, cores);
+    digThreads = std::max(1, threads);
+}
+
+void SudokuLogic::setSymmetry(Symmetry value) {
+    symmetry = value;
+}
+
+void SudokuLogic::setCluePattern(const bool pattern[SIZE][SIZE]) {
+    hasCluePattern = pattern != nullptr;
+    if (hasCluePattern) std::copy(&pattern[0][0], &pattern[0][0] + SIZE * SIZE, &cluePattern[0][0]);
 }
 
 //void SudokuLogic::printBoard(int pBoard[SIZE][SIZE]) {
@@ -171,33 +381,71 @@ void SudokuLogic::removeNumbers(int currentBoard[SIZE][SIZE], int difficulty) {
 //}
 
 bool SudokuLogic::hasUniqueSolution(int board[SIZE][SIZE], int solution[SIZE][SIZE]) {
-    int tempBoard[SIZE][SIZE];
-    std::copy(&board[0][0], &board[0][0] + SIZE * SIZE, &tempBoard[0][0]);
-
-    int solutionCount = 0;
-    solveSudoku(tempBoard, 0, 0, solutionCount);
+    int tempSolution[SIZE][SIZE];
+    int solutionCount = countSolutions(board, 2, tempSolution);
 
     if (solutionCount == 1) {
-        std::copy(&tempBoard[0][0], &tempBoard[0][0] + SIZE * SIZE, &solution[0][0]);
+        std::copy(&tempSolution[0][0], &tempSolution[0][0] + SIZE * SIZE, &solution[0][0]);
     }
 
-    qDebug() << "Found" << solutionCount << "solutions.";
+    ENGINE_LOG("Found %d solutions.", solutionCount);
     return solutionCount == 1;
 }
 
-bool SudokuLogic::isBoardCompleteAndCorrect(int board[SIZE][SIZE], int solution[SIZE][SIZE], const QVector<QVector<QString>>& cellTexts) {
-    for (int row = 0; row < SIZE; ++row) {
-        for (int col = 0; col < SIZE; ++col) {
-            QString text = cellTexts[row][col];
-            if (text.isEmpty()) {
-                return false;
-            }
-            bool ok;
-            int val = text.toInt(&ok);
-            if (!ok || val != solution[row][col]) {
-                return false;
+void SudokuLogic::setSolverBackend(SolverBackend newBackend) {
+    backend = newBackend;
+}
+
+SolverBackend SudokuLogic::solverBackend() const {
+    return backend;
+}
+
+int SudokuLogic::countSolutions(int board[SIZE][SIZE], int limit, int solution[SIZE][SIZE]) {
+    switch (backend) {
+    case SolverBackend::DancingLinks: {
+        if (!dlxSolver) dlxSolver = std::make_unique<DlxSolver>();
+        dlxSolver->setStats(&solverStats);
+        return dlxSolver->countSolutions(board, limit, solution);
+    }
+    case SolverBackend::Backtracking: {
+        int conflictRow, conflictCol;
+        if (findConflict(board, conflictRow, conflictCol)) return 0;
+
+        int tempBoard[SIZE][SIZE];
+        std::copy(&board[0][0], &board[0][0] + SIZE * SIZE, &tempBoard[0][0]);
+        int solutionCount = 0;
+        solveSudoku(tempBoard, 0, 0, solutionCount, limit, solution);
+        return std::min(solutionCount, limit);
+    }
+    case SolverBackend::Candidates:
+    default: {
+        CandidateSolver solver;
+        solver.setStats(&solverStats);
+        if (!solver.load(board)) return 0;
+        return solver.countSolutions(limit, solution);
+    }
+    }
+}
+
+bool SudokuLogic::findConflict(int board[SIZE][SIZE], int& conflictRow, int& conflictCol) {
+    CandidateSolver solver;
+    for (int row = 0; row < SIZE; row++) {
+        for (int col = 0; col < SIZE; col++) {
+            int num = board[row][col];
+            if (num == 0) continue;
+            if (!(solver.candidates(row, col) & digitBit(num))) {
+                conflictRow = row;
+                conflictCol = col;
+                return true;
             }
+            solver.place(row, col, num);
         }
     }
-    return true;
+    return false;
+}
+
+bool SudokuLogic::isConsistent(const int board[SIZE][SIZE]) {
+    UnitLanes packed;
+    packUnitLanes(board, packed);
+    return unitsConflictFree(packed);
 }
@@ -2,13 +2,31 @@
 #ifndef SUDOKULOGIC_H
 #define SUDOKULOGIC_H
 
-#include <QDebug>
-#include <random>
+#include <cstdint>
 #include <vector>
 #include <algorithm>
+#include <memory>
 
-const int SIZE = 9;
+#include "boardsize.h"
+#include "enginelog.h"
+#include "solverstats.h"
+#include "dlxsolver.h"
+#include "workstealingpool.h"
+#include "xoshiro.h"
+#include "puzzlegrader.h"
+#include "symmetry.h"
 
+const int SIZE = ClassicBoard::N;
+
+// Engines that can answer solution-count queries. All of them give the same answers,
+// they differ only in speed on different kinds of puzzles.
+enum class SolverBackend {
+    Backtracking,   // reference solveSudoku backtracker
+    Candidates,     // bitmask CandidateSolver (default)
+    DancingLinks    // exact-cover DlxSolver
+};
+
+// The 9x9 engine behind the game. Boards of other sizes go through SudokuEngine.
 class SudokuLogic {
 public:
     SudokuLogic();
@@ -16,14 +34,65 @@ public:
     // Core Sudoku algorithms
     bool isValid(int board[SIZE][SIZE], int row, int col, int num);
     bool generateFullBoard(int board[SIZE][SIZE], int row = 0, int col = 0);
-    bool solveSudoku(int board[SIZE][SIZE], int row, int col, int& solutionCount);
-    void removeNumbers(int board[SIZE][SIZE], int difficulty);
+    // Reference backtracker. Counts solutions of board until limit is reached, the default
+    // of 2 tells a unique puzzle from one that is not. The first solution is copied to
+    // solution when it is non-null, board itself is left as it was.
+    bool solveSudoku(int board[SIZE][SIZE], int row, int col, int& solutionCount, int limit = 2, int solution[SIZE][SIZE] = nullptr);
+    // Digs board, a full grid, for the difficulty (4 digs to a minimal puzzle). Returns
+    // false if the clue pattern leaves the grid with more than one solution.
+    bool removeNumbers(int board[SIZE][SIZE], int difficulty);
+
+    // Fills solution and digs board from scratch, retrying until the grader rates the
+    // puzzle inside the band of the difficulty. The same seed, difficulty, symmetry and
+    // clue pattern always give the same puzzle, on any platform and any dig thread count.
+    bool generatePuzzle(uint64_t seed, int difficulty, int board[SIZE][SIZE], int solution[SIZE][SIZE],
+        PuzzleGrade* grade = nullptr);
+    static bool inDifficultyBand(Technique hardest, int difficulty);
+
+    // Randomness. All draws come from one generator seeded with seed().
+    void seed(uint64_t value);
+    uint64_t newSeed();            // fresh non-zero seed for the next puzzle
+    int randomIndex(int count);    // uniform in [0, count)
+
+    // Generation settings
+    void setDigThreads(int threads); // > 1 checks removals in parallel, same result as 1, capped at the core count
+    void setSymmetry(Symmetry value); // givens are removed with their symmetric partner
+    // Only cells set in pattern may keep a given, null = any cell. Grids on which the
+    // pattern leaves more than one solution are skipped.
+    void setCluePattern(const bool pattern[SIZE][SIZE]);
+
+    // Solver backend selection
+    void setSolverBackend(SolverBackend backend);
+    SolverBackend solverBackend() const;
+    int countSolutions(int board[SIZE][SIZE], int limit, int solution[SIZE][SIZE] = nullptr);
+
+    // Solver statistics (see solverstats.h). Calls add to them, generatePuzzle
+    // starts over so they describe one puzzle; reset before other calls to measure.
+    const SolverStats& stats() const { return solverStats; }
+    void resetStats() { solverStats = SolverStats(); }
 
     // Helper functions
     void printBoard(int board[SIZE][SIZE]);
     bool hasUniqueSolution(int board[SIZE][SIZE], int solution[SIZE][SIZE]);
-    bool isBoardCompleteAndCorrect(int board[SIZE][SIZE], int solution[SIZE][SIZE],
-        const QVector<QVector<QString>>& cellTexts);
+    bool findConflict(int board[SIZE][SIZE], int& conflictRow, int& conflictCol);
+
+    // Whole-board check, vectorized (see simdboard.h)
+    bool isConsistent(const int board[SIZE][SIZE]); // no digit twice in a row, column or box
+
+private:
+    int removeNumbersParallel(int board[SIZE][SIZE], const std::vector<std::pair<int, int>>& cellsList, int cellsToRemove);
+
+    Xoshiro256 rng;
+    Xoshiro256 seedSource; // seeded from the OS once, only hands out puzzle seeds
+    PuzzleGrader grader;
+    int digThreads = 1;
+    Symmetry symmetry = Symmetry::None;
+    bool cluePattern[SIZE][SIZE];
+    bool hasCluePattern = false;
+    std::unique_ptr<WorkStealingPool> digPool;
+    SolverBackend backend = SolverBackend::Candidates;
+    std::unique_ptr<DlxSolver> dlxSolver; // created on first use, the matrix is ~80 KB
+    SolverStats solverStats;
 };
 
 #endif // SUDOKULOGIC_H
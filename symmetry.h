@@ -0,0 +1,28 @@
+#pragma once
+#ifndef SYMMETRY_H
+#define SYMMETRY_H
+
+#include "boardsize.h"
+
+// Symmetries a dug puzzle can keep. Every one of them pairs each cell with one
+// partner, or with itself on the axis or at the centre, so the digger removes
+// givens in groups of at most two.
+enum class Symmetry {
+    None,
+    Rotational, // 180 degrees about the centre cell
+    Mirror,     // left-right about the middle column
+    Diagonal    // about the main diagonal
+};
+
+constexpr int symmetricCell(Symmetry symmetry, int cell) {
+    const int n = ClassicBoard::N;
+    const int row = cell / n, col = cell % n;
+    switch (symmetry) {
+    case Symmetry::Rotational: return (n - 1 - row) * n + (n - 1 - col);
+    case Symmetry::Mirror: return row * n + (n - 1 - col);
+    case Symmetry::Diagonal: return col * n + row;
+    default: return cell;
+    }
+}
+
+#endif // SYMMETRY_H
@@ -0,0 +1,87 @@
+#include "workstealingpool.h"
+
+WorkStealingPool::WorkStealingPool(int threadCount) {
+    if (threadCount < 1) threadCount = 1;
+    for (int i = 0; i < threadCount; ++i) queues.push_back(std::make_unique<Queue>());
+    for (int i = 0; i < threadCount; ++i) threads.emplace_back(&WorkStealingPool::workerLoop, this, i);
+}
+
+WorkStealingPool::~WorkStealingPool() {
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (std::thread& thread : threads) thread.join();
+}
+
+bool WorkStealingPool::popLocal(int index, Task& task) {
+    Queue& queue = *queues[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) return false;
+    task = std::move(queue.tasks.back());
+    queue.tasks.pop_back();
+    queuedTasks--;
+    return true;
+}
+
+bool WorkStealingPool::steal(int thief, Task& task) {
+    int count = static_cast<int>(queues.size());
+    for (int offset = 1; offset <= count; ++offset) {
+        Queue& victim = *queues[(thief + offset) % count];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (victim.tasks.empty()) continue;
+        task = std::move(victim.tasks.front());
+        victim.tasks.pop_front();
+        queuedTasks--;
+        return true;
+    }
+    return false;
+}
+
+void WorkStealingPool::workerLoop(int index) {
+    while (true) {
+        Task task;
+        if (popLocal(index, task) || steal(index, task)) {
+            task();
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.wait(lock, [this] { return stopping || queuedTasks.load() > 0; });
+        if (stopping && queuedTasks.load() == 0) return;
+    }
+}
+
+void WorkStealingPool::parallelFor(int count, const std::function<void(int)>& task) {
+    if (count <= 0) return;
+
+    std::atomic<int> remaining(count);
+    std::mutex doneMutex;
+    std::condition_variable done;
+
+    // Deal the tasks round-robin, stealing evens out whatever is left over
+    int queueCount = static_cast<int>(queues.size());
+    for (int i = 0; i < count; ++i) {
+        Queue& queue = *queues[i % queueCount];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back([&, i] {
+            task(i);
+            // Count down under the lock so the caller cannot return while we still touch its locals
+            std::lock_guard<std::mutex> doneLock(doneMutex);
+            if (--remaining == 0) done.notify_all();
+        });
+        queuedTasks++;
+    }
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+    }
+    wake.notify_all();
+
+    // Help out instead of blocking straight away
+    Task stolen;
+    while (remaining.load() > 0 && steal(0, stolen)) stolen();
+
+    std::unique_lock<std::mutex> lock(doneMutex);
+    done.wait(lock, [&] { return remaining.load() == 0; });
+}
@@ -0,0 +1,52 @@
+#pragma once
+#ifndef WORKSTEALINGPOOL_H
+#define WORKSTEALINGPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed-size thread pool where each worker owns a task deque. Workers take
+// their own newest task first and steal the oldest task of another worker
+// when they run dry, which keeps uneven solver workloads balanced.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threadCount);
+    ~WorkStealingPool();
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    int threadCount() const { return static_cast<int>(threads.size()); }
+
+    // Runs task(i) for every i in [0, count) and returns once all have finished.
+    // The calling thread helps with the work while it waits.
+    void parallelFor(int count, const std::function<void(int)>& task);
+
+private:
+    using Task = std::function<void()>;
+
+    struct Queue {
+        std::deque<Task> tasks;
+        std::mutex mutex;
+    };
+
+    void workerLoop(int index);
+    bool popLocal(int index, Task& task);
+    bool steal(int thief, Task& task);
+
+    std::vector<std::unique_ptr<Queue>> queues;
+    std::vector<std::thread> threads;
+
+    std::mutex wakeMutex;
+    std::condition_variable wake;
+    std::atomic<int> queuedTasks{ 0 };
+    bool stopping = false;
+};
+
+#endif // WORKSTEALINGPOOL_H
@@ -0,0 +1,77 @@
+#pragma once
+#ifndef XOSHIRO_H
+#define XOSHIRO_H
+
+#include <cstdint>
+#include <utility>
+
+// xoshiro256** by Blackman and Vigna: 32 bytes of state, a few shifts and
+// multiplies per draw. Seeded through splitmix64 so any 64-bit value,
+// including small consecutive ones, gives an independent stream.
+//
+// Bounded draws and shuffle are implemented here rather than through
+// <random> distributions, whose output differs between standard libraries,
+// so a seed produces the same puzzle on every platform.
+class Xoshiro256 {
+public:
+    using result_type = uint64_t;
+
+    explicit Xoshiro256(uint64_t seedValue = 0) { seed(seedValue); }
+
+    void seed(uint64_t value) {
+        for (int i = 0; i < 4; ++i) state[i] = splitMix64(value);
+    }
+
+    uint64_t next() {
+        const uint64_t result = rotl(state[1] * 5, 7) * 9;
+        const uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform value in [0, bound), Lemire's multiply-and-reject method
+    uint32_t below(uint32_t bound) {
+        uint64_t product = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            const uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = static_cast<uint64_t>(static_cast<uint32_t>(next() >> 32)) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // Fisher-Yates shuffle
+    template <typename RandomIt>
+    void shuffle(RandomIt first, RandomIt last) {
+        for (auto i = last - first; i > 1; --i) {
+            std::swap(first[i - 1], first[below(static_cast<uint32_t>(i))]);
+        }
+    }
+
+    // UniformRandomBitGenerator interface
+    static constexpr result_type min() { return 0; }
+    static constexpr result_type max() { return ~result_type(0); }
+    result_type operator()() { return next(); }
+
+private:
+    static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+    static uint64_t splitMix64(uint64_t& x) {
+        uint64_t z = (x += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    uint64_t state[4];
+};
+
+#endif // XOSHIRO_H